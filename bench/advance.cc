@@ -0,0 +1,79 @@
+#include "bench/kinematic_bicycle.h"
+#include "benchmark/benchmark.h"
+#include "ode/iterator.h"
+#include "ode/state_space/system.h"
+#include "ode/stepper.h"
+
+#include <chrono>
+#include <cstddef>
+#include <iterator>
+
+namespace {
+
+using namespace std::literals::chrono_literals;
+
+using bicycle = bench::kinematic_bicycle<double>;
+
+constexpr auto horizon = 10s;
+constexpr auto step = 10ms;
+constexpr auto steps = std::size_t{horizon / step};
+
+const auto sys = ode::state_space::make_system<bicycle::state, bicycle::input>(
+    bicycle::transition_function<bench::units_math>{});
+
+auto range() -> decltype(auto)
+{
+    return sys.integrate_range<ode::stepper::runge_kutta4>(
+        bicycle::initial_state(), bicycle::input{}, horizon, step);
+}
+
+// Visits every state, keeping the last
+void iterate(benchmark::State& bench)
+{
+    for (auto _ : bench) {
+        auto last = bicycle::state{};
+        for (auto result : range()) {
+            last = result.second;
+        }
+        benchmark::DoNotOptimize(last);
+    }
+
+    bench.SetItemsProcessed(bench.iterations() * steps);
+}
+
+// Advances to the last state without visiting the states before it
+void advance(benchmark::State& bench)
+{
+    for (auto _ : bench) {
+        auto r = range();
+        auto first = r.begin();
+
+        using std::distance;
+        first.advance(distance(first, r.end()) - 1);
+        benchmark::DoNotOptimize((*first).second);
+    }
+
+    bench.SetItemsProcessed(bench.iterations() * steps);
+}
+
+// Visits every `k`-th state
+void stride(benchmark::State& bench)
+{
+    const auto k = bench.range(0);
+
+    for (auto _ : bench) {
+        for (auto result : ode::stride(range(), k)) {
+            benchmark::DoNotOptimize(result.second);
+        }
+    }
+
+    bench.SetItemsProcessed(bench.iterations() * steps);
+}
+
+BENCHMARK(iterate);
+BENCHMARK(advance);
+BENCHMARK(stride)->Arg(1)->Arg(10)->Arg(100);
+
+}  // namespace
+
+BENCHMARK_MAIN();
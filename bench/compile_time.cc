@@ -0,0 +1,34 @@
+// Instantiates a state vector of `ODE_BENCH_KEYS` keys together with its derivative, key lookup
+// and a single integration step, so that the cost of compiling it can be measured with
+// `compile_time.sh`.
+
+#include "bench/linear_chain.h"
+#include "ode/state_space/system.h"
+#include "ode/stepper.h"
+#include "units.h"
+
+#include <cstddef>
+
+#ifndef ODE_BENCH_KEYS
+#define ODE_BENCH_KEYS 64
+#endif
+
+namespace {
+
+constexpr auto keys = std::size_t{ODE_BENCH_KEYS};
+
+using chain = bench::linear_chain<double, keys>;
+
+}  // namespace
+
+auto main() -> int
+{
+    const auto sys = ode::state_space::make_system<chain::state, chain::input>(
+        chain::transition_function{});
+
+    const auto x = sys.integrate<ode::stepper::runge_kutta4>(
+        chain::initial_state(), chain::input{1.0}, units::time::second_t{0.01});
+
+    return static_cast<int>(x.get<bench::key<0>>().value() +
+                            x.get<bench::key<keys - 1>>().value());
+}
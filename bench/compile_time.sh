@@ -0,0 +1,21 @@
+#!/bin/bash
+#
+# Reports the front-end time and memory GCC takes to compile `compile_time.cc` for a range of
+# state sizes. Arguments are passed to the compiler, e.g. the include path of the units library:
+#
+#   $ CXX=g++ bench/compile_time.sh -Iextern/units/include
+
+cxx=${CXX:-g++}
+root=$(cd "$(dirname "$0")/.." && pwd)
+
+printf "%8s %12s %12s\n" keys "wall [s]" "memory"
+for keys in ${KEYS:-8 64 256 1024}; do
+    total=$(${cxx} -std=c++14 -fsyntax-only -ftime-report -DODE_BENCH_KEYS=${keys} \
+        -I"${root}" -I"${root}/include" "$@" "${root}/bench/compile_time.cc" 2>&1 |
+        grep "TOTAL")
+    if [ -z "${total}" ]; then
+        printf "%8s %12s\n" "${keys}" failed
+        continue
+    fi
+    printf "%8s %12s %12s\n" "${keys}" $(echo "${total}" | awk '{ print $5, $6 }')
+done
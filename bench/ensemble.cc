@@ -0,0 +1,127 @@
+#include "bench/kinematic_bicycle.h"
+#include "benchmark/benchmark.h"
+#include "ode/state_space/ensemble.h"
+#include "ode/state_space/system.h"
+#include "ode/state_space/vector.h"
+#include "ode/stepper.h"
+#include "ode/thread_pool.h"
+#include "units.h"
+
+#include <chrono>
+#include <cstddef>
+#include <vector>
+
+namespace {
+
+using namespace std::literals::chrono_literals;
+
+using model = bench::kinematic_bicycle<double>;
+using state = model::state;
+using input = model::input;
+
+const auto kinematic_bicycle = ode::state_space::make_system<state, input>(
+    model::transition_function<bench::units_math>{});
+
+constexpr auto steps = std::size_t{30};
+
+auto initial_states(std::size_t lanes) -> std::vector<state>
+{
+    auto x0 = std::vector<state>{};
+    x0.reserve(lanes);
+
+    for (auto i = std::size_t{}; i < lanes; ++i) {
+        x0.push_back({model::length_type(0),
+                      model::length_type(0),
+                      model::angle_type(0.001 * i),
+                      model::velocity_type(10)});
+    }
+
+    return x0;
+}
+
+auto inputs(std::size_t lanes) -> std::vector<input>
+{
+    auto u = std::vector<input>{};
+    u.reserve(lanes);
+
+    for (auto i = std::size_t{}; i < lanes; ++i) {
+        u.push_back({model::acceleration_type(0), model::angle_type(0.2 - 0.4 * i / lanes)});
+    }
+
+    return u;
+}
+
+void per_trajectory(benchmark::State& bench)
+{
+    const auto lanes = static_cast<std::size_t>(bench.range(0));
+    const auto x0 = initial_states(lanes);
+    const auto u = inputs(lanes);
+
+    for (auto _ : bench) {
+        for (auto i = std::size_t{}; i < lanes; ++i) {
+            auto x = x0[i];
+            for (auto j = std::size_t{}; j < steps; ++j) {
+                x = kinematic_bicycle.integrate<ode::stepper::runge_kutta4>(x, u[i], 100ms);
+            }
+            benchmark::DoNotOptimize(x);
+        }
+    }
+
+    bench.SetItemsProcessed(bench.iterations() * lanes * steps);
+}
+
+void batched(benchmark::State& bench)
+{
+    const auto lanes = static_cast<std::size_t>(bench.range(0));
+    const auto x0 = initial_states(lanes);
+    const auto u = inputs(lanes);
+
+    for (auto _ : bench) {
+        auto x = kinematic_bicycle.integrate_batch<ode::stepper::runge_kutta4>(x0, u, 100ms, steps);
+        benchmark::DoNotOptimize(x);
+    }
+
+    bench.SetItemsProcessed(bench.iterations() * lanes * steps);
+}
+
+void parallel(benchmark::State& bench)
+{
+    constexpr auto lanes = std::size_t{4096};
+    const auto x0 = initial_states(lanes);
+    const auto u = inputs(lanes);
+
+    ode::thread_pool pool{static_cast<std::size_t>(bench.range(0)), true};
+
+    for (auto _ : bench) {
+        auto x = ode::state_space::integrate_ensemble<ode::stepper::runge_kutta4>(
+            pool,
+            kinematic_bicycle,
+            x0,
+            u,
+            steps * 100ms,
+            100ms,
+            ode::state_space::final_state<state>{});
+        benchmark::DoNotOptimize(x);
+    }
+
+    bench.SetItemsProcessed(bench.iterations() * lanes * steps);
+}
+
+// Doubles the number of threads up to the number of cores
+void thread_counts(benchmark::internal::Benchmark* b)
+{
+    const auto cores = ode::thread_pool::default_thread_count();
+
+    for (auto threads = std::size_t{1}; threads < cores; threads *= 2) {
+        b->Arg(static_cast<int>(threads));
+    }
+    b->Arg(static_cast<int>(cores));
+}
+
+BENCHMARK(per_trajectory)->RangeMultiplier(8)->Range(64, 32768);
+BENCHMARK(batched)->RangeMultiplier(8)->Range(64, 32768);
+BENCHMARK(parallel)->Apply(thread_counts)->UseRealTime();
+
+}  // namespace
+
+BENCHMARK_MAIN();
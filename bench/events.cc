@@ -0,0 +1,84 @@
+#include "bench/kinematic_bicycle.h"
+#include "benchmark/benchmark.h"
+#include "ode/event.h"
+#include "ode/state_space/system.h"
+#include "ode/stepper.h"
+#include "units.h"
+
+#include <chrono>
+#include <cstddef>
+
+namespace {
+
+using namespace std::literals::chrono_literals;
+
+using bicycle = bench::kinematic_bicycle<double>;
+
+constexpr auto horizon = 10s;
+constexpr auto step = 10ms;
+
+// Braking to a stop from 10 m/s at 3 m/s^2 takes 3.33 s of the 10 s horizon.
+auto braking_input() -> bicycle::input
+{
+    return {bicycle::acceleration_type(-3), bicycle::angle_type(0.05)};
+}
+
+auto speed(const bicycle::state& x) -> bicycle::velocity_type { return x.get<bench::v>(); }
+
+const auto sys = ode::state_space::make_system<bicycle::state, bicycle::input>(
+    bicycle::transition_function<bench::units_math>{});
+
+// Integrates the full horizon and searches the samples for the first at which the vehicle has
+// stopped.
+void post_filter(benchmark::State& bench)
+{
+    auto steps = std::size_t{};
+
+    for (auto _ : bench) {
+        auto stop = bicycle::state{};
+        auto found = false;
+        steps = 0;
+
+        for (auto result : sys.integrate_range<ode::stepper::runge_kutta4>(
+                 bicycle::initial_state(), braking_input(), horizon, step)) {
+            if (!found && (speed(result.second) <= bicycle::velocity_type(0))) {
+                stop = result.second;
+                found = true;
+            }
+            ++steps;
+        }
+        benchmark::DoNotOptimize(stop);
+    }
+
+    bench.counters["steps"] = static_cast<double>(steps);
+}
+
+// Ends integration at the state where the speed crosses zero, located on the interpolant of the
+// step.
+void early_termination(benchmark::State& bench)
+{
+    const auto stop = ode::make_event(speed, ode::event_direction::falling);
+
+    auto steps = std::size_t{};
+
+    for (auto _ : bench) {
+        auto x = bicycle::state{};
+        steps = 0;
+
+        for (auto result : sys.integrate_events<ode::stepper::runge_kutta4>(
+                 bicycle::initial_state(), braking_input(), horizon, step, stop)) {
+            x = result.second;
+            ++steps;
+        }
+        benchmark::DoNotOptimize(x);
+    }
+
+    bench.counters["steps"] = static_cast<double>(steps);
+}
+
+BENCHMARK(post_filter);
+BENCHMARK(early_termination);
+
+}  // namespace
+
+BENCHMARK_MAIN();
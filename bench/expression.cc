@@ -0,0 +1,95 @@
+#include "bench/linear_chain.h"
+#include "benchmark/benchmark.h"
+#include "ode/state_space/vector.h"
+#include "units.h"
+
+#include <cstddef>
+
+namespace {
+
+constexpr auto size = std::size_t{40};
+
+template <class Real>
+using chain = bench::linear_chain<Real, size>;
+
+template <class Real>
+struct operands {
+    using state = typename chain<Real>::state;
+    using deriv = typename chain<Real>::deriv;
+
+    static auto make() -> operands
+    {
+        const auto x = chain<Real>::initial_state();
+        const auto f = typename chain<Real>::transition_function{};
+        const auto u = typename chain<Real>::input{1.0};
+        const auto t = units::time::second_t{};
+
+        const auto k = f(x, u, t);
+
+        return {x, k, Real{2} * k, Real{3} * k, Real{4} * k};
+    }
+
+    state x;
+    deriv k1;
+    deriv k2;
+    deriv k3;
+    deriv k4;
+};
+
+// Factors in the precision of the state, which would otherwise be multiplied in `double`
+template <class Real>
+using scalar = units::unit_t<units::dimensionless::scalar, Real>;
+
+template <class Real>
+constexpr auto dt = units::unit_t<units::time::seconds, Real>{0.001};
+
+// Final combination of a classic Runge-Kutta step, evaluating each operation into a vector as
+// arithmetic on vectors did before expression templates
+template <class Real>
+void rk4_combination_eager(benchmark::State& bench)
+{
+    using state = typename operands<Real>::state;
+    using deriv = typename operands<Real>::deriv;
+
+    auto a = operands<Real>::make();
+
+    for (auto _ : bench) {
+        benchmark::DoNotOptimize(a);
+        const deriv k23 = a.k2 + a.k3;
+        const deriv k23_2 = scalar<Real>{2} * k23;
+        const deriv k123 = a.k1 + k23_2;
+        const deriv k1234 = k123 + a.k4;
+        const state dx = dt<Real> / scalar<Real>{6} * k1234;
+        const state x = a.x + dx;
+        benchmark::DoNotOptimize(x);
+    }
+
+    bench.SetItemsProcessed(bench.iterations() * size);
+}
+
+// The same combination evaluated as a single expression in one pass over the elements
+template <class Real>
+void rk4_combination_fused(benchmark::State& bench)
+{
+    using state = typename operands<Real>::state;
+
+    auto a = operands<Real>::make();
+
+    for (auto _ : bench) {
+        benchmark::DoNotOptimize(a);
+        const state x = a.x + dt<Real> / scalar<Real>{6} *
+                                  (a.k1 + scalar<Real>{2} * (a.k2 + a.k3) + a.k4);
+        benchmark::DoNotOptimize(x);
+    }
+
+    bench.SetItemsProcessed(bench.iterations() * size);
+}
+
+BENCHMARK_TEMPLATE(rk4_combination_eager, float);
+BENCHMARK_TEMPLATE(rk4_combination_eager, double);
+BENCHMARK_TEMPLATE(rk4_combination_fused, float);
+BENCHMARK_TEMPLATE(rk4_combination_fused, double);
+
+}  // namespace
+
+BENCHMARK_MAIN();
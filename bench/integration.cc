@@ -0,0 +1,243 @@
+#include "bench/kinematic_bicycle.h"
+#include "bench/linear_chain.h"
+#include "benchmark/benchmark.h"
+#include "boost/numeric/odeint.hpp"
+#include "ode/iterator.h"
+#include "ode/odeint/model.h"
+#include "ode/state_space/system.h"
+#include "ode/stepper.h"
+#include "units.h"
+
+#include <chrono>
+#include <cstddef>
+#include <ratio>
+#include <type_traits>
+
+namespace {
+
+using namespace std::literals::chrono_literals;
+namespace odeint = boost::numeric::odeint;
+
+constexpr auto span = 3s;
+constexpr auto step = 10ms;
+constexpr auto steps = static_cast<std::size_t>(span / step);
+
+// Each sample of `integrate_trajectory` is integrated from the previous one.
+constexpr auto trajectory_samples = steps;
+constexpr auto trajectory_steps = trajectory_samples - 1;
+
+constexpr auto rk4_stages = std::size_t{4};
+
+// Steppers without a `stages` member are fourth-order Runge-Kutta methods.
+template <class Stepper, class = void>
+struct stage_count : std::integral_constant<std::size_t, rk4_stages> {};
+
+template <class Stepper>
+struct stage_count<Stepper, ode::tmp::void_t<decltype(Stepper::stages)>>
+    : std::integral_constant<std::size_t, Stepper::stages> {};
+
+auto set_counters(benchmark::State& bench, std::size_t n, std::size_t stages = rk4_stages)
+    -> void
+{
+    bench.SetItemsProcessed(bench.iterations() * n);
+    bench.counters["rhs_eval"] =
+        benchmark::Counter(static_cast<double>(n * stages),
+                           benchmark::Counter::kIsIterationInvariantRate |
+                               benchmark::Counter::kInvert);
+}
+
+template <class Real>
+using bicycle = bench::kinematic_bicycle<Real>;
+
+template <class Real>
+void bicycle_raw(benchmark::State& bench)
+{
+    const auto dt = std::chrono::duration<Real>{step}.count();
+
+    for (auto _ : bench) {
+        auto s = typename bicycle<Real>::raw_state{0, 0, 0, 10};
+        for (auto i = std::size_t{}; i < steps; ++i) {
+            s = bicycle<Real>::raw_step(s, Real{0}, Real{0.2}, dt);
+            benchmark::DoNotOptimize(s);
+        }
+    }
+
+    set_counters(bench, steps);
+}
+
+template <class Real>
+void bicycle_odeint_model(benchmark::State& bench)
+{
+    using Model = ode::odeint::model<Real, std::ratio<1105, 1000>, std::ratio<1738, 1000>>;
+    using length_type = typename Model::length_type;
+    using angle_type = typename Model::angle_type;
+    using velocity_type = typename Model::velocity_type;
+    using acceleration_type = typename Model::acceleration_type;
+
+    const auto x0 =
+        typename Model::state{length_type(0), length_type(0), angle_type(0), velocity_type(10)};
+    const auto u = typename Model::input{acceleration_type(0), angle_type(0.2)};
+
+    for (auto _ : bench) {
+        for (auto result :
+             ode::make_owning_step_range<Model, odeint::runge_kutta4>(x0, u, span, step)) {
+            benchmark::DoNotOptimize(result.second);
+        }
+    }
+
+    set_counters(bench, steps);
+}
+
+template <class Real, template <class...> class Stepper>
+void bicycle_system(benchmark::State& bench)
+{
+    const auto sys = ode::state_space::make_system<typename bicycle<Real>::state,
+                                                   typename bicycle<Real>::input>(
+        typename bicycle<Real>::template transition_function<bench::units_math>{});
+    const auto x0 = bicycle<Real>::initial_state();
+    const auto u = bicycle<Real>::nominal_input();
+
+    for (auto _ : bench) {
+        for (auto result : sys.template integrate_range<Stepper>(x0, u, span, step)) {
+            benchmark::DoNotOptimize(result.second);
+        }
+    }
+
+    using system_type = std::decay_t<decltype(sys)>;
+    set_counters(
+        bench,
+        steps,
+        stage_count<typename system_type::template specialize_stepper<Stepper>>::value);
+}
+
+template <class Real>
+void bicycle_trajectory(benchmark::State& bench)
+{
+    const auto sys = ode::state_space::make_system<typename bicycle<Real>::state,
+                                                   typename bicycle<Real>::input>(
+        typename bicycle<Real>::template transition_function<bench::gcem_math>{});
+    const auto x0 = bicycle<Real>::initial_state();
+    const auto u = bicycle<Real>::nominal_input();
+
+    for (auto _ : bench) {
+        const auto trajectory =
+            sys.template integrate_trajectory<ode::stepper::runge_kutta4, trajectory_samples>(
+                x0, u, step);
+        benchmark::DoNotOptimize(trajectory);
+    }
+
+    set_counters(bench, trajectory_steps);
+}
+
+template <class Real, std::size_t N>
+using chain = bench::linear_chain<Real, N>;
+
+template <class Real, std::size_t N>
+void chain_raw(benchmark::State& bench)
+{
+    const auto dt = std::chrono::duration<Real>{step}.count();
+
+    for (auto _ : bench) {
+        auto s = chain<Real, N>::raw_initial_state();
+        for (auto i = std::size_t{}; i < steps; ++i) {
+            s = chain<Real, N>::raw_step(s, Real{1}, dt);
+            benchmark::DoNotOptimize(s);
+        }
+    }
+
+    set_counters(bench, steps);
+}
+
+template <class Real, std::size_t N, template <class...> class Stepper>
+void chain_system(benchmark::State& bench)
+{
+    const auto sys = ode::state_space::make_system<typename chain<Real, N>::state,
+                                                   typename chain<Real, N>::input>(
+        typename chain<Real, N>::transition_function{});
+    const auto x0 = chain<Real, N>::initial_state();
+    const auto u = typename chain<Real, N>::input{1.0};
+
+    for (auto _ : bench) {
+        for (auto result : sys.template integrate_range<Stepper>(x0, u, span, step)) {
+            benchmark::DoNotOptimize(result.second);
+        }
+    }
+
+    using system_type = std::decay_t<decltype(sys)>;
+    set_counters(
+        bench,
+        steps,
+        stage_count<typename system_type::template specialize_stepper<Stepper>>::value);
+}
+
+template <class Real, std::size_t N>
+void chain_trajectory(benchmark::State& bench)
+{
+    const auto sys = ode::state_space::make_system<typename chain<Real, N>::state,
+                                                   typename chain<Real, N>::input>(
+        typename chain<Real, N>::transition_function{});
+    const auto x0 = chain<Real, N>::initial_state();
+    const auto u = typename chain<Real, N>::input{1.0};
+
+    for (auto _ : bench) {
+        const auto trajectory =
+            sys.template integrate_trajectory<ode::stepper::runge_kutta4, trajectory_samples>(
+                x0, u, step);
+        benchmark::DoNotOptimize(trajectory);
+    }
+
+    set_counters(bench, trajectory_steps);
+}
+
+BENCHMARK_TEMPLATE(bicycle_raw, float);
+BENCHMARK_TEMPLATE(bicycle_raw, double);
+BENCHMARK_TEMPLATE(bicycle_odeint_model, float);
+BENCHMARK_TEMPLATE(bicycle_odeint_model, double);
+BENCHMARK_TEMPLATE(bicycle_system, float, odeint::runge_kutta4);
+BENCHMARK_TEMPLATE(bicycle_system, double, odeint::runge_kutta4);
+BENCHMARK_TEMPLATE(bicycle_system, float, ode::stepper::runge_kutta4);
+BENCHMARK_TEMPLATE(bicycle_system, double, ode::stepper::runge_kutta4);
+BENCHMARK_TEMPLATE(bicycle_system, float, ode::stepper::classic_runge_kutta4);
+BENCHMARK_TEMPLATE(bicycle_system, double, ode::stepper::classic_runge_kutta4);
+BENCHMARK_TEMPLATE(bicycle_system, double, ode::stepper::euler);
+BENCHMARK_TEMPLATE(bicycle_system, double, ode::stepper::heun);
+BENCHMARK_TEMPLATE(bicycle_system, double, ode::stepper::runge_kutta3);
+BENCHMARK_TEMPLATE(bicycle_system, double, ode::stepper::three_eighths_runge_kutta4);
+BENCHMARK_TEMPLATE(bicycle_system, double, ode::stepper::cash_karp5);
+BENCHMARK_TEMPLATE(bicycle_trajectory, float);
+BENCHMARK_TEMPLATE(bicycle_trajectory, double);
+
+BENCHMARK_TEMPLATE(chain_raw, float, 4);
+BENCHMARK_TEMPLATE(chain_raw, double, 4);
+BENCHMARK_TEMPLATE(chain_raw, float, 16);
+BENCHMARK_TEMPLATE(chain_raw, double, 16);
+BENCHMARK_TEMPLATE(chain_raw, float, 64);
+BENCHMARK_TEMPLATE(chain_raw, double, 64);
+BENCHMARK_TEMPLATE(chain_system, float, 4, odeint::runge_kutta4);
+BENCHMARK_TEMPLATE(chain_system, double, 4, odeint::runge_kutta4);
+BENCHMARK_TEMPLATE(chain_system, float, 16, odeint::runge_kutta4);
+BENCHMARK_TEMPLATE(chain_system, double, 16, odeint::runge_kutta4);
+BENCHMARK_TEMPLATE(chain_system, float, 64, odeint::runge_kutta4);
+BENCHMARK_TEMPLATE(chain_system, double, 64, odeint::runge_kutta4);
+BENCHMARK_TEMPLATE(chain_system, float, 4, ode::stepper::runge_kutta4);
+BENCHMARK_TEMPLATE(chain_system, double, 4, ode::stepper::runge_kutta4);
+BENCHMARK_TEMPLATE(chain_system, float, 16, ode::stepper::runge_kutta4);
+BENCHMARK_TEMPLATE(chain_system, double, 16, ode::stepper::runge_kutta4);
+BENCHMARK_TEMPLATE(chain_system, float, 64, ode::stepper::runge_kutta4);
+BENCHMARK_TEMPLATE(chain_system, double, 64, ode::stepper::runge_kutta4);
+BENCHMARK_TEMPLATE(chain_system, float, 4, ode::stepper::classic_runge_kutta4);
+BENCHMARK_TEMPLATE(chain_system, double, 4, ode::stepper::classic_runge_kutta4);
+BENCHMARK_TEMPLATE(chain_system, float, 16, ode::stepper::classic_runge_kutta4);
+BENCHMARK_TEMPLATE(chain_system, double, 16, ode::stepper::classic_runge_kutta4);
+BENCHMARK_TEMPLATE(chain_system, float, 64, ode::stepper::classic_runge_kutta4);
+BENCHMARK_TEMPLATE(chain_system, double, 64, ode::stepper::classic_runge_kutta4);
+BENCHMARK_TEMPLATE(chain_trajectory, float, 4);
+BENCHMARK_TEMPLATE(chain_trajectory, double, 4);
+BENCHMARK_TEMPLATE(chain_trajectory, float, 16);
+BENCHMARK_TEMPLATE(chain_trajectory, double, 16);
+BENCHMARK_TEMPLATE(chain_trajectory, float, 64);
+BENCHMARK_TEMPLATE(chain_trajectory, double, 64);
+
+}  // namespace
+
+BENCHMARK_MAIN();
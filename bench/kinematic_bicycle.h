@@ -0,0 +1,175 @@
+#pragma once
+
+#include "ode/gcem_units.h"
+#include "ode/state_space/vector.h"
+#include "units.h"
+
+#include <array>
+#include <cmath>
+
+namespace bench {
+
+// Keys are named so that states may be written to a trajectory file or sent as a wire message.
+struct x {
+    static constexpr auto name() -> const char* { return "x"; }
+};
+
+struct y {
+    static constexpr auto name() -> const char* { return "y"; }
+};
+
+struct yaw {
+    static constexpr auto name() -> const char* { return "yaw"; }
+};
+
+struct v {
+    static constexpr auto name() -> const char* { return "v"; }
+};
+
+struct a {
+    static constexpr auto name() -> const char* { return "a"; }
+};
+
+struct deltaf {
+    static constexpr auto name() -> const char* { return "deltaf"; }
+};
+
+/// Trigonometric functions evaluated with `units::math`
+struct units_math {
+    template <class Angle>
+    static auto sin(Angle t)
+    {
+        return units::math::sin(t);
+    }
+
+    template <class Angle>
+    static auto cos(Angle t)
+    {
+        return units::math::cos(t);
+    }
+
+    template <class Angle>
+    static auto tan(Angle t)
+    {
+        return units::math::tan(t);
+    }
+
+    template <class Scalar>
+    static auto atan(Scalar s)
+    {
+        return units::math::atan(s);
+    }
+};
+
+/// Trigonometric functions evaluated with `gcem`, allowing use in constant expressions
+using gcem_math = ode::math::functions<ode::math::compile_time>;
+
+/// Kinematic bicycle model shared by benchmarks
+/// @tparam Real type
+template <class Real>
+struct kinematic_bicycle {
+    using length_type = units::unit_t<units::length::meter, Real>;
+    using angle_type = units::unit_t<units::angle::radian, Real>;
+    using velocity_type = units::unit_t<units::velocity::meters_per_second, Real>;
+    using acceleration_type = units::unit_t<units::acceleration::meters_per_second_squared, Real>;
+
+    using state = ode::state_space::vector<x,
+                                           length_type,
+                                           y,
+                                           length_type,
+                                           yaw,
+                                           angle_type,
+                                           v,
+                                           velocity_type>;
+
+    using input = ode::state_space::vector<a, acceleration_type, deltaf, angle_type>;
+
+    using deriv = typename state::template derivative<>;
+
+    static constexpr auto lf = units::length::meter_t{1.105};
+    static constexpr auto lr = units::length::meter_t{1.738};
+
+    template <class Math>
+    struct transition_function {
+        /// Input together with the vehicle course, which depends only on the input
+        struct prepared_input {
+            input u;
+            units::angle::radian_t beta;
+        };
+
+        constexpr auto prepare(const input& u) const -> prepared_input
+        {
+            return {u, Math::atan(lr / (lf + lr) * Math::tan(u.template get<deltaf>()))};
+        }
+
+        constexpr auto operator()(const state& sx,
+                                  const prepared_input& p,
+                                  units::time::second_t) const -> deriv
+        {
+            return {sx.template get<v>() * Math::cos(sx.template get<yaw>() + p.beta),
+                    sx.template get<v>() * Math::sin(sx.template get<yaw>() + p.beta),
+                    sx.template get<v>() / lr * Math::sin(p.beta) * units::angle::radian_t{1},
+                    p.u.template get<a>()};
+        }
+
+        constexpr auto operator()(const state& sx, const input& u, units::time::second_t t) const
+            -> deriv
+        {
+            return (*this)(sx, prepare(u), t);
+        }
+    };
+
+    static constexpr auto initial_state() -> state
+    {
+        return {length_type(0), length_type(0), angle_type(0), velocity_type(10)};
+    }
+
+    static constexpr auto nominal_input() -> input
+    {
+        return {acceleration_type(0), angle_type(0.2)};
+    }
+
+    /// Hand-written baseline without units
+    using raw_state = std::array<Real, 4>;
+
+    static auto raw_deriv(const raw_state& s, Real accel, Real steer) -> raw_state
+    {
+        const auto l_f = static_cast<Real>(lf.value());
+        const auto l_r = static_cast<Real>(lr.value());
+
+        const auto beta = std::atan(l_r / (l_f + l_r) * std::tan(steer));
+
+        return {s[3] * std::cos(s[2] + beta),
+                s[3] * std::sin(s[2] + beta),
+                s[3] / l_r * std::sin(beta),
+                accel};
+    }
+
+    static auto raw_step(const raw_state& s, Real accel, Real steer, Real dt) -> raw_state
+    {
+        const auto axpy = [](Real alpha, const raw_state& dx, const raw_state& x0) {
+            return raw_state{x0[0] + alpha * dx[0],
+                             x0[1] + alpha * dx[1],
+                             x0[2] + alpha * dx[2],
+                             x0[3] + alpha * dx[3]};
+        };
+
+        const auto k1 = raw_deriv(s, accel, steer);
+        const auto k2 = raw_deriv(axpy(dt / 2, k1, s), accel, steer);
+        const auto k3 = raw_deriv(axpy(dt / 2, k2, s), accel, steer);
+        const auto k4 = raw_deriv(axpy(dt, k3, s), accel, steer);
+
+        auto next = s;
+        for (auto i = std::size_t{}; i < next.size(); ++i) {
+            next[i] += dt / 6 * (k1[i] + 2 * (k2[i] + k3[i]) + k4[i]);
+        }
+        return next;
+    }
+};
+
+template <class Real>
+constexpr units::length::meter_t kinematic_bicycle<Real>::lf;
+template <class Real>
+constexpr units::length::meter_t kinematic_bicycle<Real>::lr;
+
+}  // namespace bench
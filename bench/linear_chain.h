@@ -0,0 +1,117 @@
+#pragma once
+
+#include "ode/state_space/vector.h"
+#include "ode/tmp/type_traits.h"
+#include "units.h"
+
+#include <array>
+#include <cstddef>
+#include <utility>
+
+namespace bench {
+
+template <std::size_t I>
+struct key;
+
+struct gain;
+
+/// A ring of `N` coupled first order lags, used to benchmark arbitrary state sizes
+/// @tparam Real type
+/// @tparam N number of states
+template <class Real, std::size_t N>
+struct linear_chain {
+  private:
+    using length_type = units::unit_t<units::length::meter, Real>;
+
+    template <class>
+    struct make_state;
+
+    template <std::size_t... Is>
+    struct make_state<std::index_sequence<Is...>> {
+        using type = ode::tmp::rebind_outer<
+            ode::tmp::interleave<ode::tmp::list<key<Is>...>, ode::tmp::repeat<N, length_type>>,
+            ode::state_space::vector>;
+    };
+
+  public:
+    using state = typename make_state<std::make_index_sequence<N>>::type;
+    using input =
+        ode::state_space::vector<gain, units::unit_t<units::dimensionless::scalar, Real>>;
+    using deriv = typename state::template derivative<>;
+
+    struct transition_function {
+        template <class Duration>
+        constexpr auto operator()(const state& sx, const input& u, Duration) const -> deriv
+        {
+            return impl(sx, u, std::make_index_sequence<N>{});
+        }
+
+      private:
+        template <std::size_t... Is>
+        static constexpr auto impl(const state& sx, const input& u, std::index_sequence<Is...>)
+            -> deriv
+        {
+            constexpr auto tau = units::unit_t<units::time::seconds, Real>{1};
+
+            return {(u.template get<gain>() *
+                     (sx.template get<key<(Is + 1) % N>>() - sx.template get<key<Is>>()) / tau)...};
+        }
+    };
+
+    static constexpr auto initial_state() -> state
+    {
+        return initial_state_impl(std::make_index_sequence<N>{});
+    }
+
+    /// Hand-written baseline without units
+    using raw_state = std::array<Real, N>;
+
+    static auto raw_deriv(const raw_state& s, Real k) -> raw_state
+    {
+        auto dxdt = raw_state{};
+        for (auto i = std::size_t{}; i < N; ++i) {
+            dxdt[i] = k * (s[(i + 1) % N] - s[i]);
+        }
+        return dxdt;
+    }
+
+    static auto raw_step(const raw_state& s, Real k, Real dt) -> raw_state
+    {
+        const auto axpy = [](Real alpha, const raw_state& dx, const raw_state& x0) {
+            auto y = x0;
+            for (auto i = std::size_t{}; i < N; ++i) {
+                y[i] += alpha * dx[i];
+            }
+            return y;
+        };
+
+        const auto k1 = raw_deriv(s, k);
+        const auto k2 = raw_deriv(axpy(dt / 2, k1, s), k);
+        const auto k3 = raw_deriv(axpy(dt / 2, k2, s), k);
+        const auto k4 = raw_deriv(axpy(dt, k3, s), k);
+
+        auto next = s;
+        for (auto i = std::size_t{}; i < N; ++i) {
+            next[i] += dt / 6 * (k1[i] + 2 * (k2[i] + k3[i]) + k4[i]);
+        }
+        return next;
+    }
+
+    static auto raw_initial_state() -> raw_state
+    {
+        auto s = raw_state{};
+        for (auto i = std::size_t{}; i < N; ++i) {
+            s[i] = static_cast<Real>(i);
+        }
+        return s;
+    }
+
+  private:
+    template <std::size_t... Is>
+    static constexpr auto initial_state_impl(std::index_sequence<Is...>) -> state
+    {
+        return {length_type(static_cast<Real>(Is))...};
+    }
+};
+
+}  // namespace bench
@@ -0,0 +1,176 @@
+#include "bench/kinematic_bicycle.h"
+#include "benchmark/benchmark.h"
+#include "ode/gcem_units.h"
+#include "ode/state_space/system.h"
+#include "ode/stepper.h"
+#include "units.h"
+
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+
+namespace {
+
+using namespace std::literals::chrono_literals;
+namespace math = ode::math;
+
+constexpr auto samples = std::size_t{1024};
+
+struct sin_function {
+    template <class Policy, class Real>
+    static auto evaluate(Real x) -> Real
+    {
+        return Policy::sin(x);
+    }
+
+    static auto reference(long double x) -> long double { return std::sin(x); }
+
+    // Inputs are spread over a few periods
+    static constexpr auto range = 10.0;
+};
+
+struct cos_function {
+    template <class Policy, class Real>
+    static auto evaluate(Real x) -> Real
+    {
+        return Policy::cos(x);
+    }
+
+    static auto reference(long double x) -> long double { return std::cos(x); }
+
+    static constexpr auto range = 10.0;
+};
+
+struct tan_function {
+    template <class Policy, class Real>
+    static auto evaluate(Real x) -> Real
+    {
+        return Policy::tan(x);
+    }
+
+    static auto reference(long double x) -> long double { return std::tan(x); }
+
+    // Inputs are kept clear of the poles so that the error is that of the approximation
+    static constexpr auto range = 1.4;
+};
+
+struct atan_function {
+    template <class Policy, class Real>
+    static auto evaluate(Real x) -> Real
+    {
+        return Policy::atan(x);
+    }
+
+    static auto reference(long double x) -> long double { return std::atan(x); }
+
+    static constexpr auto range = 10.0;
+};
+
+template <class Function, class Real>
+auto inputs() -> std::array<Real, samples>
+{
+    auto x = std::array<Real, samples>{};
+    for (auto i = std::size_t{}; i < samples; ++i) {
+        x[i] = static_cast<Real>(Function::range * (2.0 * static_cast<double>(i) / samples - 1.0));
+    }
+    return x;
+}
+
+// Evaluates a function of each of an array of inputs, allowing calls to be vectorized. The
+// largest absolute error over the inputs with respect to evaluation in `long double` is
+// reported as `max_error`.
+template <class Function, class Policy, class Real>
+void function(benchmark::State& bench)
+{
+    const auto x = inputs<Function, Real>();
+    auto y = std::array<Real, samples>{};
+
+    for (auto _ : bench) {
+        benchmark::DoNotOptimize(x.data());
+        for (auto i = std::size_t{}; i < samples; ++i) {
+            y[i] = Function::template evaluate<Policy>(x[i]);
+        }
+        benchmark::ClobberMemory();
+    }
+
+    auto error = 0.0L;
+    for (auto i = std::size_t{}; i < samples; ++i) {
+        error = std::fmax(error, std::fabs(y[i] - Function::reference(x[i])));
+    }
+
+    bench.SetItemsProcessed(bench.iterations() * samples);
+    bench.counters["max_error"] = static_cast<double>(error);
+}
+
+template <class Real>
+using bicycle = bench::kinematic_bicycle<Real>;
+
+constexpr auto span = 3s;
+constexpr auto step = 10ms;
+constexpr auto steps = static_cast<std::size_t>(span / step);
+
+template <class Real, class Policy>
+auto final_state() -> typename bicycle<Real>::state
+{
+    const auto sys = ode::state_space::make_system<typename bicycle<Real>::state,
+                                                   typename bicycle<Real>::input>(
+        typename bicycle<Real>::template transition_function<math::functions<Policy>>{});
+
+    auto x = bicycle<Real>::initial_state();
+    for (auto i = std::size_t{}; i < steps; ++i) {
+        x = sys.template integrate<ode::stepper::runge_kutta4>(
+            x, bicycle<Real>::nominal_input(), step);
+    }
+    return x;
+}
+
+// Integrates the kinematic bicycle with trigonometric functions of each policy. `position_error`
+// is the distance from the final position integrated with `math::standard`.
+template <class Real, class Policy>
+void bicycle_system(benchmark::State& bench)
+{
+    const auto reference = final_state<Real, math::standard>();
+
+    auto xf = typename bicycle<Real>::state{};
+    for (auto _ : bench) {
+        xf = final_state<Real, Policy>();
+        benchmark::DoNotOptimize(xf);
+    }
+
+    bench.SetItemsProcessed(bench.iterations() * steps);
+    bench.counters["position_error"] =
+        std::hypot(xf.template get<bench::x>().value() -
+                       reference.template get<bench::x>().value(),
+                   xf.template get<bench::y>().value() -
+                       reference.template get<bench::y>().value());
+}
+
+BENCHMARK_TEMPLATE(function, sin_function, math::standard, double);
+BENCHMARK_TEMPLATE(function, sin_function, math::compile_time, double);
+BENCHMARK_TEMPLATE(function, sin_function, math::polynomial<6>, double);
+BENCHMARK_TEMPLATE(function, sin_function, math::polynomial<12>, double);
+BENCHMARK_TEMPLATE(function, sin_function, math::standard, float);
+BENCHMARK_TEMPLATE(function, sin_function, math::polynomial<6>, float);
+BENCHMARK_TEMPLATE(function, cos_function, math::standard, double);
+BENCHMARK_TEMPLATE(function, cos_function, math::compile_time, double);
+BENCHMARK_TEMPLATE(function, cos_function, math::polynomial<6>, double);
+BENCHMARK_TEMPLATE(function, cos_function, math::polynomial<12>, double);
+BENCHMARK_TEMPLATE(function, tan_function, math::standard, double);
+BENCHMARK_TEMPLATE(function, tan_function, math::compile_time, double);
+BENCHMARK_TEMPLATE(function, tan_function, math::polynomial<6>, double);
+BENCHMARK_TEMPLATE(function, tan_function, math::polynomial<12>, double);
+BENCHMARK_TEMPLATE(function, atan_function, math::standard, double);
+BENCHMARK_TEMPLATE(function, atan_function, math::compile_time, double);
+BENCHMARK_TEMPLATE(function, atan_function, math::polynomial<6>, double);
+BENCHMARK_TEMPLATE(function, atan_function, math::polynomial<12>, double);
+BENCHMARK_TEMPLATE(bicycle_system, double, math::standard);
+BENCHMARK_TEMPLATE(bicycle_system, double, math::compile_time);
+BENCHMARK_TEMPLATE(bicycle_system, double, math::polynomial<6>);
+BENCHMARK_TEMPLATE(bicycle_system, double, math::polynomial<12>);
+BENCHMARK_TEMPLATE(bicycle_system, float, math::standard);
+BENCHMARK_TEMPLATE(bicycle_system, float, math::polynomial<6>);
+
+}  // namespace
+
+BENCHMARK_MAIN();
@@ -0,0 +1,82 @@
+#include "bench/kinematic_bicycle.h"
+#include "benchmark/benchmark.h"
+#include "ode/observer.h"
+#include "ode/state_space/system.h"
+#include "ode/stepper.h"
+
+#include <chrono>
+#include <cstddef>
+
+namespace {
+
+using namespace std::literals::chrono_literals;
+
+using bicycle = bench::kinematic_bicycle<double>;
+
+constexpr auto horizon = 10s;
+constexpr auto step = 10ms;
+constexpr auto steps = std::size_t{horizon / step};
+
+const auto sys = ode::state_space::make_system<bicycle::state, bicycle::input>(
+    bicycle::transition_function<bench::units_math>{});
+
+auto set_counters(benchmark::State& bench) -> void
+{
+    bench.SetItemsProcessed(bench.iterations() * steps);
+    bench.counters["per_step"] = benchmark::Counter(
+        static_cast<double>(steps),
+        benchmark::Counter::kIsIterationInvariantRate | benchmark::Counter::kInvert);
+}
+
+// Integrates without an observer
+void uninstrumented(benchmark::State& bench)
+{
+    for (auto _ : bench) {
+        for (auto result : sys.integrate_range<ode::stepper::runge_kutta4>(
+                 bicycle::initial_state(), bicycle::input{}, horizon, step)) {
+            benchmark::DoNotOptimize(result.second);
+        }
+    }
+
+    set_counters(bench);
+}
+
+template <class Observer>
+void observed(benchmark::State& bench)
+{
+    auto observer = Observer{};
+
+    for (auto _ : bench) {
+        for (auto result : sys.integrate_range<ode::stepper::runge_kutta4>(
+                 bicycle::initial_state(), bicycle::input{}, horizon, step, observer)) {
+            benchmark::DoNotOptimize(result.second);
+        }
+    }
+
+    set_counters(bench);
+}
+
+// Records a timeline, cleared after each integration so that memory use stays bounded
+void traced(benchmark::State& bench)
+{
+    auto observer = ode::trace_observer{steps};
+
+    for (auto _ : bench) {
+        for (auto result : sys.integrate_range<ode::stepper::runge_kutta4>(
+                 bicycle::initial_state(), bicycle::input{}, horizon, step, observer)) {
+            benchmark::DoNotOptimize(result.second);
+        }
+        observer.clear();
+    }
+
+    set_counters(bench);
+}
+
+BENCHMARK(uninstrumented);
+BENCHMARK_TEMPLATE(observed, ode::null_observer);
+BENCHMARK_TEMPLATE(observed, ode::counting_observer);
+BENCHMARK(traced);
+
+}  // namespace
+
+BENCHMARK_MAIN();
@@ -0,0 +1,138 @@
+#include "bench/kinematic_bicycle.h"
+#include "benchmark/benchmark.h"
+#include "ode/state_space/parareal.h"
+#include "ode/state_space/system.h"
+#include "ode/stepper.h"
+#include "ode/thread_pool.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+
+namespace {
+
+using namespace std::literals::chrono_literals;
+
+using model = bench::kinematic_bicycle<double>;
+using state = model::state;
+
+const auto kinematic_bicycle = ode::state_space::make_system<state, model::input>(
+    model::transition_function<bench::units_math>{});
+
+constexpr auto horizon = std::chrono::milliseconds{10min};
+constexpr auto fine_step = 1ms;
+constexpr auto coarse_step = 1s;
+constexpr auto fine_steps = static_cast<std::size_t>(horizon / fine_step);
+
+const auto tolerance = state{model::length_type(1e-6),
+                             model::length_type(1e-6),
+                             model::angle_type(1e-9),
+                             model::velocity_type(1e-9)};
+
+auto serial_range() -> state
+{
+    auto x = state{};
+    for (auto result : kinematic_bicycle.integrate_range<ode::stepper::runge_kutta4>(
+             model::initial_state(), model::nominal_input(), horizon, fine_step)) {
+        x = result.second;
+    }
+    return x;
+}
+
+// Final state of a serial integration with the fine step, including the state at the horizon
+// that `integrate_range` does not visit
+auto serial_final_state() -> state
+{
+    auto x = model::initial_state();
+    for (auto i = std::size_t{}; i < fine_steps; ++i) {
+        x = kinematic_bicycle.integrate<ode::stepper::runge_kutta4>(
+            x, model::nominal_input(), fine_step);
+    }
+    return x;
+}
+
+// Shortest wall time of a few serial integrations with `integrate_range`, measured once
+auto serial_seconds() -> double
+{
+    static const auto seconds = [] {
+        auto shortest = std::chrono::duration<double>::max();
+        for (auto i = 0; i < 5; ++i) {
+            const auto start = std::chrono::steady_clock::now();
+            benchmark::DoNotOptimize(serial_range());
+            shortest = std::min<std::chrono::duration<double>>(
+                shortest, std::chrono::steady_clock::now() - start);
+        }
+        return shortest.count();
+    }();
+
+    return seconds;
+}
+
+// Integrates with `integrate_range` on the calling thread
+void serial(benchmark::State& bench)
+{
+    for (auto _ : bench) {
+        benchmark::DoNotOptimize(serial_range());
+    }
+}
+
+// Integrates with `integrate_parareal` with one slice per thread. `speedup` is the wall time of
+// `serial` divided by the wall time of `integrate_parareal` and `position_error` is the distance
+// of the final position from the serial integration.
+void parareal(benchmark::State& bench)
+{
+    const auto threads = static_cast<std::size_t>(bench.range(0));
+    const auto reference = serial_final_state();
+    const auto serial_time = serial_seconds();
+
+    ode::thread_pool pool{threads, true};
+
+    auto result = ode::state_space::parareal_result<state>{};
+    auto elapsed = std::chrono::duration<double>{};
+
+    for (auto _ : bench) {
+        const auto start = std::chrono::steady_clock::now();
+        result = ode::state_space::integrate_parareal<ode::stepper::runge_kutta4,
+                                                      ode::stepper::runge_kutta4>(
+            pool,
+            kinematic_bicycle,
+            model::initial_state(),
+            model::nominal_input(),
+            horizon,
+            threads,
+            coarse_step,
+            fine_step,
+            tolerance,
+            threads);
+        elapsed += std::chrono::steady_clock::now() - start;
+        benchmark::DoNotOptimize(result);
+    }
+
+    const auto& xf = result.states.back();
+
+    bench.counters["speedup"] =
+        serial_time / (elapsed.count() / static_cast<double>(bench.iterations()));
+    bench.counters["iterations"] = static_cast<double>(result.iterations);
+    bench.counters["position_error"] =
+        std::hypot(xf.get<bench::x>().value() - reference.get<bench::x>().value(),
+                   xf.get<bench::y>().value() - reference.get<bench::y>().value());
+}
+
+// Doubles the number of threads up to the number of cores
+void thread_counts(benchmark::internal::Benchmark* b)
+{
+    const auto cores = ode::thread_pool::default_thread_count();
+
+    for (auto threads = std::size_t{1}; threads < cores; threads *= 2) {
+        b->Arg(static_cast<int>(threads));
+    }
+    b->Arg(static_cast<int>(cores));
+}
+
+BENCHMARK(serial)->Unit(benchmark::kMillisecond)->UseRealTime();
+BENCHMARK(parareal)->Apply(thread_counts)->Unit(benchmark::kMillisecond)->UseRealTime();
+
+}  // namespace
+
+BENCHMARK_MAIN();
@@ -0,0 +1,148 @@
+#include "bench/kinematic_bicycle.h"
+#include "bench/linear_chain.h"
+#include "benchmark/benchmark.h"
+#include "ode/state_space/system.h"
+#include "ode/stepper.h"
+#include "units.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <vector>
+
+namespace {
+
+using namespace std::literals::chrono_literals;
+
+// Each benchmark is instantiated with the precision of the state `Real` and the precision of
+// time and of the combination of each step `StepReal`:
+// - `double, double`: double precision
+// - `float, float`: single precision
+// - `float, double`: mixed precision, rounding the state to `float` once per step
+
+constexpr auto span = 10s;
+constexpr auto step = 10ms;
+constexpr auto steps = static_cast<std::size_t>(span / step);
+
+template <class Real>
+using bicycle = bench::kinematic_bicycle<Real>;
+
+template <class Real, class StepReal>
+auto bicycle_final_state() -> typename bicycle<Real>::state
+{
+    const auto sys = ode::state_space::make_system<typename bicycle<Real>::state,
+                                                   typename bicycle<Real>::input,
+                                                   StepReal>(
+        typename bicycle<Real>::template transition_function<bench::units_math>{});
+
+    auto x = typename bicycle<Real>::state{};
+    for (auto result : sys.template integrate_range<ode::stepper::runge_kutta4>(
+             bicycle<Real>::initial_state(), bicycle<Real>::nominal_input(), span, step)) {
+        x = result.second;
+    }
+    return x;
+}
+
+// Integrates the kinematic bicycle. `position_error` is the distance of the final position from
+// that integrated in double precision.
+template <class Real, class StepReal>
+void bicycle_system(benchmark::State& bench)
+{
+    const auto reference = bicycle_final_state<double, double>();
+
+    auto xf = typename bicycle<Real>::state{};
+    for (auto _ : bench) {
+        xf = bicycle_final_state<Real, StepReal>();
+        benchmark::DoNotOptimize(xf);
+    }
+
+    bench.SetItemsProcessed(bench.iterations() * steps);
+    bench.counters["position_error"] = std::hypot(
+        static_cast<double>(xf.template get<bench::x>().value()) -
+            reference.template get<bench::x>().value(),
+        static_cast<double>(xf.template get<bench::y>().value()) -
+            reference.template get<bench::y>().value());
+}
+
+template <class Real>
+using chain = bench::linear_chain<Real, 64>;
+
+template <class Real, class StepReal>
+auto chain_final_state() -> typename chain<Real>::state
+{
+    const auto sys = ode::state_space::make_system<typename chain<Real>::state,
+                                                   typename chain<Real>::input,
+                                                   StepReal>(
+        typename chain<Real>::transition_function{});
+
+    auto x = typename chain<Real>::state{};
+    for (auto result : sys.template integrate_range<ode::stepper::runge_kutta4>(
+             chain<Real>::initial_state(), typename chain<Real>::input{0.5}, span, step)) {
+        x = result.second;
+    }
+    return x;
+}
+
+// Integrates a ring of 64 coupled lags. `max_error` is the largest absolute difference of a
+// final state from that integrated in double precision.
+template <class Real, class StepReal>
+void chain_system(benchmark::State& bench)
+{
+    const auto reference = chain_final_state<double, double>();
+
+    auto xf = typename chain<Real>::state{};
+    for (auto _ : bench) {
+        xf = chain_final_state<Real, StepReal>();
+        benchmark::DoNotOptimize(xf);
+    }
+
+    auto error = 0.0;
+    xf.for_each(
+        [&error](const auto& x, const auto& r) {
+            error = std::max(error, std::abs(static_cast<double>(x.value()) - r.value()));
+        },
+        reference);
+
+    bench.SetItemsProcessed(bench.iterations() * steps);
+    bench.counters["max_error"] = error;
+}
+
+// Integrates 4096 kinematic bicycles with `integrate_batch`
+template <class Real, class StepReal>
+void bicycle_batch(benchmark::State& bench)
+{
+    constexpr auto lanes = std::size_t{4096};
+    constexpr auto batch_steps = std::size_t{30};
+
+    using model = bicycle<Real>;
+
+    const auto sys =
+        ode::state_space::make_system<typename model::state, typename model::input, StepReal>(
+            typename model::template transition_function<bench::units_math>{});
+
+    const auto x0 = std::vector<typename model::state>(lanes, model::initial_state());
+    const auto u = std::vector<typename model::input>(lanes, model::nominal_input());
+
+    for (auto _ : bench) {
+        auto x =
+            sys.template integrate_batch<ode::stepper::runge_kutta4>(x0, u, 100ms, batch_steps);
+        benchmark::DoNotOptimize(x);
+    }
+
+    bench.SetItemsProcessed(bench.iterations() * lanes * batch_steps);
+}
+
+BENCHMARK_TEMPLATE(bicycle_system, double, double);
+BENCHMARK_TEMPLATE(bicycle_system, float, float);
+BENCHMARK_TEMPLATE(bicycle_system, float, double);
+BENCHMARK_TEMPLATE(chain_system, double, double);
+BENCHMARK_TEMPLATE(chain_system, float, float);
+BENCHMARK_TEMPLATE(chain_system, float, double);
+BENCHMARK_TEMPLATE(bicycle_batch, double, double);
+BENCHMARK_TEMPLATE(bicycle_batch, float, float);
+BENCHMARK_TEMPLATE(bicycle_batch, float, double);
+
+}  // namespace
+
+BENCHMARK_MAIN();
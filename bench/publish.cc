@@ -0,0 +1,133 @@
+#include "bench/kinematic_bicycle.h"
+#include "benchmark/benchmark.h"
+#include "ode/state_space/shared_trajectory.h"
+#include "ode/state_space/system.h"
+#include "ode/stepper.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <thread>
+
+#include <unistd.h>
+
+namespace {
+
+using namespace std::literals::chrono_literals;
+
+using bicycle = bench::kinematic_bicycle<double>;
+
+using publisher =
+    ode::state_space::trajectory_publisher<bicycle::state, std::chrono::nanoseconds, 4096>;
+using subscriber =
+    ode::state_space::trajectory_subscriber<bicycle::state, std::chrono::nanoseconds, 4096>;
+
+constexpr auto horizon = 10s;
+constexpr auto step = 10ms;
+constexpr auto steps = std::size_t{horizon / step};
+
+const auto sys = ode::state_space::make_system<bicycle::state, bicycle::input>(
+    bicycle::transition_function<bench::units_math>{});
+
+auto shared_name() -> std::string { return "/ode_bench_publish_" + std::to_string(::getpid()); }
+
+auto set_counters(benchmark::State& bench, std::size_t samples) -> void
+{
+    bench.SetItemsProcessed(bench.iterations() * samples);
+    bench.counters["per_sample"] = benchmark::Counter(
+        static_cast<double>(samples),
+        benchmark::Counter::kIsIterationInvariantRate | benchmark::Counter::kInvert);
+}
+
+// Integrates without publishing
+void integrate(benchmark::State& bench)
+{
+    for (auto _ : bench) {
+        for (auto result : sys.integrate_range<ode::stepper::runge_kutta4>(
+                 bicycle::initial_state(), bicycle::input{}, horizon, step)) {
+            benchmark::DoNotOptimize(result.second);
+        }
+    }
+
+    set_counters(bench, steps);
+}
+
+// Integrates, publishing each sample to shared memory
+void integrate_and_publish(benchmark::State& bench)
+{
+    publisher p{shared_name()};
+
+    for (auto _ : bench) {
+        for (auto result : ode::state_space::make_publishing_range(
+                 sys.integrate_range<ode::stepper::runge_kutta4>(
+                     bicycle::initial_state(), bicycle::input{}, horizon, step),
+                 p)) {
+            benchmark::DoNotOptimize(result.second);
+        }
+    }
+
+    set_counters(bench, steps);
+}
+
+// Publishes a single sample
+void publish(benchmark::State& bench)
+{
+    publisher p{shared_name()};
+    const auto x = bicycle::initial_state();
+    auto elapsed = std::chrono::nanoseconds{};
+
+    for (auto _ : bench) {
+        p.publish(elapsed, x);
+        elapsed += step;
+    }
+
+    set_counters(bench, 1);
+}
+
+// Publishes a single sample while a subscriber in another thread reads every sample it can,
+// contending for the cache lines of the ring
+void publish_with_subscriber(benchmark::State& bench)
+{
+    publisher p{shared_name()};
+    const auto x = bicycle::initial_state();
+    auto elapsed = std::chrono::nanoseconds{};
+
+    std::atomic<bool> done{false};
+    auto read = std::uint64_t{};
+    auto lost = std::uint64_t{};
+
+    auto reader = std::thread{[&] {
+        auto s = subscriber{p.name()};
+        auto sample = subscriber::value_type{};
+
+        while (!done.load(std::memory_order_relaxed)) {
+            if (s.try_read(sample) == ode::state_space::read_status::value) {
+                ++read;
+            }
+        }
+        lost = s.lost();
+    }};
+
+    for (auto _ : bench) {
+        p.publish(elapsed, x);
+        elapsed += step;
+    }
+
+    done = true;
+    reader.join();
+
+    set_counters(bench, 1);
+    bench.counters["read"] = static_cast<double>(read);
+    bench.counters["lost"] = static_cast<double>(lost);
+}
+
+BENCHMARK(integrate);
+BENCHMARK(integrate_and_publish);
+BENCHMARK(publish);
+BENCHMARK(publish_with_subscriber)->UseRealTime();
+
+}  // namespace
+
+BENCHMARK_MAIN();
@@ -0,0 +1,76 @@
+#pragma once
+
+#include "bench/kinematic_bicycle.h"
+#include "ode/state_space/vector.h"
+#include "units.h"
+
+namespace bench {
+
+struct steer;
+
+/// Kinematic bicycle whose steering angle follows the commanded angle through a fast first
+/// order actuator, making the system stiff
+/// @tparam Real type
+template <class Real>
+struct steered_bicycle {
+    using length_type = units::unit_t<units::length::meter, Real>;
+    using angle_type = units::unit_t<units::angle::radian, Real>;
+    using velocity_type = units::unit_t<units::velocity::meters_per_second, Real>;
+    using acceleration_type = units::unit_t<units::acceleration::meters_per_second_squared, Real>;
+
+    using state = ode::state_space::vector<x,
+                                           length_type,
+                                           y,
+                                           length_type,
+                                           yaw,
+                                           angle_type,
+                                           v,
+                                           velocity_type,
+                                           steer,
+                                           angle_type>;
+
+    using input = ode::state_space::vector<a, acceleration_type, deltaf, angle_type>;
+
+    static constexpr auto lf = units::length::meter_t{1.105};
+    static constexpr auto lr = units::length::meter_t{1.738};
+
+    /// Time constant of the steering actuator
+    static constexpr auto tau = units::time::second_t{0.001};
+
+    /// Generic over the state and input so that Jacobians may be evaluated with `autodiff::dual`
+    template <class Math>
+    struct transition_function {
+        template <class State, class Input>
+        constexpr auto operator()(const State& sx, const Input& u, units::time::second_t) const
+            -> typename State::template derivative<>
+        {
+            const auto beta =
+                Math::atan(lr / (lf + lr) * Math::tan(sx.template get<steer>()));
+
+            return {sx.template get<v>() * Math::cos(sx.template get<yaw>() + beta),
+                    sx.template get<v>() * Math::sin(sx.template get<yaw>() + beta),
+                    sx.template get<v>() / lr * Math::sin(beta) * units::angle::radian_t{1},
+                    u.template get<a>(),
+                    (u.template get<deltaf>() - sx.template get<steer>()) / tau};
+        }
+    };
+
+    static constexpr auto initial_state() -> state
+    {
+        return {length_type(0), length_type(0), angle_type(0), velocity_type(10), angle_type(0)};
+    }
+
+    static constexpr auto nominal_input() -> input
+    {
+        return {acceleration_type(0.5), angle_type(0.2)};
+    }
+};
+
+template <class Real>
+constexpr units::length::meter_t steered_bicycle<Real>::lf;
+template <class Real>
+constexpr units::length::meter_t steered_bicycle<Real>::lr;
+template <class Real>
+constexpr units::time::second_t steered_bicycle<Real>::tau;
+
+}  // namespace bench
@@ -0,0 +1,64 @@
+#include "bench/kinematic_bicycle.h"
+#include "bench/steered_bicycle.h"
+#include "benchmark/benchmark.h"
+#include "ode/state_space/system.h"
+#include "ode/stepper.h"
+#include "units.h"
+
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+
+namespace {
+
+using namespace std::literals::chrono_literals;
+
+using model = bench::steered_bicycle<double>;
+using state = model::state;
+using input = model::input;
+
+const auto steered_bicycle = ode::state_space::make_system<state, input>(
+    model::transition_function<bench::units_math>{});
+
+constexpr auto span = std::chrono::microseconds{3s};
+
+template <template <class...> class Stepper>
+auto final_state(std::chrono::microseconds step) -> state
+{
+    auto x = model::initial_state();
+    for (auto i = std::size_t{}; i < static_cast<std::size_t>(span / step); ++i) {
+        x = steered_bicycle.integrate<Stepper>(x, model::nominal_input(), step);
+    }
+    return x;
+}
+
+// Integrated with a step well below the time constant of the steering actuator
+const auto reference = final_state<ode::stepper::runge_kutta4>(10us);
+
+// Steps are given in microseconds. Explicit methods diverge once the step exceeds the stability
+// limit set by the steering actuator, whereas the Rosenbrock method remains stable at steps many
+// times its time constant.
+template <template <class...> class Stepper>
+void stiff(benchmark::State& bench)
+{
+    const auto step = std::chrono::microseconds{bench.range(0)};
+    const auto steps = static_cast<std::size_t>(span / step);
+
+    auto xf = state{};
+    for (auto _ : bench) {
+        xf = final_state<Stepper>(step);
+        benchmark::DoNotOptimize(xf);
+    }
+
+    bench.SetItemsProcessed(bench.iterations() * steps);
+    bench.counters["position_error"] =
+        std::hypot(xf.get<bench::x>().value() - reference.get<bench::x>().value(),
+                   xf.get<bench::y>().value() - reference.get<bench::y>().value());
+}
+
+BENCHMARK_TEMPLATE(stiff, ode::stepper::runge_kutta4)->Arg(100)->Arg(1000)->Arg(2500)->Arg(5000);
+BENCHMARK_TEMPLATE(stiff, ode::stepper::rosenbrock3)->Arg(1000)->Arg(10000)->Arg(50000);
+
+}  // namespace
+
+BENCHMARK_MAIN();
@@ -6,6 +6,7 @@
 #include "units.h"
 
 #include <chrono>
+#include <cstddef>
 #include <iostream>
 
 namespace {
@@ -50,11 +51,8 @@ struct f {
 constexpr auto kinematic_bicycle = ode::state_space::make_system<state, input>(f{});
 
 constexpr auto trajectory =
-    kinematic_bicycle.integrate_trajectory<ode::stepper::runge_kutta4,
-                                           std::chrono::seconds,
-                                           3,
-                                           std::chrono::milliseconds,
-                                           100>({0_m, 0_m, 0_rad, 10_mps}, {0_mps_sq, 0.2_rad});
+    kinematic_bicycle.integrate_trajectory<ode::stepper::runge_kutta4, 30>(
+        {0_m, 0_m, 0_rad, 10_mps}, {0_mps_sq, 0.2_rad}, 100ms);
 
 }  // namespace
 
@@ -64,5 +62,18 @@ int main()
         std::cout << units::time::second_t{x.first} << ": " << x.second << std::endl;
     }
 
+    // At run time, trigonometric functions are evaluated with the standard library rather than
+    // gcem, and the trajectory matches the one integrated at compile time to rounding error
+    const auto live = kinematic_bicycle.integrate_trajectory<ode::stepper::runge_kutta4, 30>(
+        {0_m, 0_m, 0_rad, 10_mps}, {0_mps_sq, 0.2_rad}, 100ms);
+
+    auto deviation = 0_m;
+    for (auto i = std::size_t{}; i < live.size(); ++i) {
+        deviation = units::math::fmax(
+            deviation,
+            units::math::fabs(live[i].second.get<x>() - trajectory[i].second.get<x>()));
+    }
+    std::cout << "deviation of x at run time: " << deviation << std::endl;
+
     return 0;
 }
@@ -0,0 +1,72 @@
+#include "ode/autodiff.h"
+#include "ode/state_space/system.h"
+#include "ode/state_space/vector.h"
+#include "ode/stepper.h"
+#include "units.h"
+
+#include <chrono>
+#include <iostream>
+#include <type_traits>
+
+namespace {
+
+using namespace units::literals;
+using namespace std::literals::chrono_literals;
+
+using state = ode::state_space::vector<struct x,
+                                       units::length::meter_t,
+                                       struct y,
+                                       units::length::meter_t,
+                                       struct yaw,
+                                       units::angle::radian_t,
+                                       struct v,
+                                       units::velocity::meters_per_second_t>;
+
+using input = ode::state_space::vector<struct a,
+                                       units::acceleration::meters_per_second_squared_t,
+                                       struct deltaf,
+                                       units::angle::radian_t>;
+
+// The transition function is generic over its state and input so that it may also be evaluated
+// with vectors of `ode::autodiff::dual`s.
+const auto kinematic_bicycle = ode::state_space::make_system<state, input>(
+    [](const auto& sx, const auto& u, auto) {
+        using deriv = typename std::decay_t<decltype(sx)>::template derivative<>;
+
+        constexpr auto lf = 1.105_m;
+        constexpr auto lr = 1.738_m;
+
+        const auto beta =
+            units::math::atan(lr / (lf + lr) * units::math::tan(u.template get<deltaf>()));
+
+        return deriv{sx.template get<v>() * units::math::cos(sx.template get<yaw>() + beta),
+                     sx.template get<v>() * units::math::sin(sx.template get<yaw>() + beta),
+                     sx.template get<v>() / lr * units::math::sin(beta) * 1_rad,
+                     u.template get<a>()};
+    });
+
+}  // namespace
+
+int main()
+{
+    const auto x0 = state{0_m, 0_m, 0.3_rad, 10_mps};
+    const auto u = input{0_mps_sq, 0.2_rad};
+
+    const auto continuous = kinematic_bicycle.linearize(x0, u);
+    std::cout << "df/dx: " << continuous.a << std::endl;
+    std::cout << "df/du: " << continuous.b << std::endl;
+
+    const auto discrete =
+        kinematic_bicycle.linearize_step<ode::stepper::runge_kutta4>(x0, u, 100ms);
+    std::cout << "A: " << discrete.a << std::endl;
+    std::cout << "B: " << discrete.b << std::endl;
+
+    // Each entry has the unit of its row divided by the unit of its column.
+    using meters_per_radian_t = units::unit_t<
+        units::compound_unit<units::length::meters, units::inverse<units::angle::radians>>>;
+
+    const meters_per_radian_t dx_dyaw = discrete.a.get<x, yaw>();
+    std::cout << "dx/dyaw: " << dx_dyaw << std::endl;
+
+    return 0;
+}
@@ -0,0 +1,83 @@
+#include "ode/schedule.h"
+#include "ode/state_space/system.h"
+#include "ode/state_space/vector.h"
+#include "ode/stepper.h"
+#include "units.h"
+
+#include <array>
+#include <chrono>
+#include <iostream>
+#include <utility>
+
+namespace {
+
+using namespace units::literals;
+using namespace std::literals::chrono_literals;
+
+using state = ode::state_space::vector<struct x,
+                                       units::length::meter_t,
+                                       struct y,
+                                       units::length::meter_t,
+                                       struct yaw,
+                                       units::angle::radian_t,
+                                       struct v,
+                                       units::velocity::meters_per_second_t>;
+
+using input = ode::state_space::vector<struct a,
+                                       units::acceleration::meters_per_second_squared_t,
+                                       struct deltaf,
+                                       units::angle::radian_t>;
+using deriv = state::derivative<>;
+
+const auto kinematic_bicycle = ode::state_space::make_system<state, input>(
+    [](const state& sx, const input& u, units::time::second_t t) -> deriv {
+        (void)t;
+
+        constexpr auto lf = 1.105_m;
+        constexpr auto lr = 1.738_m;
+
+        const auto beta =
+            units::math::atan(lr / (lf + lr) * units::math::tan(u.template get<deltaf>()));
+
+        return {sx.template get<v>() * units::math::cos(sx.template get<yaw>() + beta),
+                sx.template get<v>() * units::math::sin(sx.template get<yaw>() + beta),
+                sx.template get<v>() / lr * units::math::sin(beta) * 1_rad,
+                u.template get<a>()};
+    }
+
+);
+
+}  // namespace
+
+int main()
+{
+    const auto x0 = state{0_m, 0_m, 0_rad, 10_mps};
+
+    // Steering changes between the steps of the integration grid are integrated exactly.
+    const auto maneuver = std::array<std::pair<std::chrono::milliseconds, input>, 3>{{
+        {0ms, {0_mps_sq, 0.2_rad}},
+        {1250ms, {0_mps_sq, -0.2_rad}},
+        {2050ms, {-1_mps_sq, 0_rad}},
+    }};
+
+    std::cout << "zero-order hold" << std::endl;
+    for (const auto result : kinematic_bicycle.integrate_schedule<ode::stepper::runge_kutta4>(
+             x0, ode::make_zero_order_hold(maneuver), 3s, 100ms)) {
+        std::cout << units::time::second_t{result.first} << ": " << result.second << std::endl;
+    }
+
+    // A sampled controller steering towards y = 5 m, evaluated every 250 ms from the state.
+    const auto controller = ode::make_generated_input<input>(
+        250ms, [](std::chrono::milliseconds, const state& sx) -> input {
+            const auto heading = 0.1_rad / 1_m * (5_m - sx.template get<y>());
+            return {0_mps_sq, 0.5 * (heading - sx.template get<yaw>())};
+        });
+
+    std::cout << "generated input" << std::endl;
+    for (const auto result : kinematic_bicycle.integrate_schedule<ode::stepper::runge_kutta4>(
+             x0, controller, 3s, 100ms)) {
+        std::cout << units::time::second_t{result.first} << ": " << result.second << std::endl;
+    }
+
+    return 0;
+}
@@ -0,0 +1,86 @@
+#include "boost/numeric/odeint.hpp"
+#include "ode/iterator.h"
+#include "ode/observer.h"
+#include "ode/odeint/vector_space_algebra.h"
+#include "ode/state_space/system.h"
+#include "ode/state_space/vector.h"
+#include "units.h"
+
+#include <chrono>
+#include <iostream>
+
+namespace {
+
+using namespace units::literals;
+
+using state = ode::state_space::vector<struct x,
+                                       units::length::meter_t,
+                                       struct y,
+                                       units::length::meter_t,
+                                       struct yaw,
+                                       units::angle::radian_t,
+                                       struct v,
+                                       units::velocity::meters_per_second_t>;
+
+using input = ode::state_space::vector<struct a,
+                                       units::acceleration::meters_per_second_squared_t,
+                                       struct deltaf,
+                                       units::angle::radian_t>;
+
+const auto kinematic_bicycle = ode::state_space::make_system<state, input>([](const auto& u) {
+    return [u](const auto& sx, auto& dxdt, auto) {
+        constexpr auto lf = 1.105_m;
+        constexpr auto lr = 1.738_m;
+
+        const auto beta =
+            units::math::atan(lr / (lf + lr) * units::math::tan(u.template get<deltaf>()));
+
+        dxdt.template get<x>() =
+            sx.template get<v>() * units::math::cos(sx.template get<yaw>() + beta);
+        dxdt.template get<y>() =
+            sx.template get<v>() * units::math::sin(sx.template get<yaw>() + beta);
+        dxdt.template get<yaw>() = sx.template get<v>() / lr * units::math::sin(beta) * 1_rad;
+        dxdt.template get<v>() = u.template get<a>();
+    };
+});
+
+using system_type = std::decay_t<decltype(kinematic_bicycle)>;
+
+}  // namespace
+
+int main()
+{
+    namespace odeint = boost::numeric::odeint;
+
+    using seconds = std::chrono::duration<double>;
+    using milliseconds = std::chrono::milliseconds;
+
+    const auto x0 = state{0_m, 0_m, 0_rad, 10_mps};
+    const auto u = input{0_mps_sq, 0.2_rad};
+
+    // Steps of varying size, each visited after it is accepted
+    auto steps = ode::counting_observer{};
+    const auto controlled = odeint::make_controlled(
+        1e-6, 1e-6, system_type::specialize_stepper<odeint::runge_kutta_dopri5>{});
+
+    for (const auto result :
+         kinematic_bicycle.integrate_range(controlled, x0, u, seconds{3}, seconds{0.1}, steps)) {
+        std::cout << units::time::second_t{result.first} << ": " << result.second << std::endl;
+    }
+    std::cout << steps.steps() << " steps, " << steps.rejected_steps() << " rejected, "
+              << steps.rhs_evaluations() << " evaluations" << std::endl;
+
+    // States interpolated every 100 ms from steps of varying size
+    auto samples = ode::counting_observer{};
+    const auto dense = odeint::make_dense_output(
+        1e-6, 1e-6, system_type::specialize_stepper<odeint::runge_kutta_dopri5>{});
+
+    for (const auto result : kinematic_bicycle.integrate_range(
+             dense, x0, u, milliseconds{3000}, milliseconds{100}, samples)) {
+        std::cout << units::time::second_t{result.first} << ": " << result.second << std::endl;
+    }
+    std::cout << samples.steps() << " steps, " << samples.rhs_evaluations() << " evaluations"
+              << std::endl;
+
+    return 0;
+}
@@ -0,0 +1,476 @@
+#pragma once
+
+#include "ode/state_space/vector.h"
+#include "ode/tmp/type_traits.h"
+#include "units.h"
+
+#include <cstddef>
+#include <iosfwd>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+namespace ode {
+namespace autodiff {
+
+/// @brief Type of the partial derivative of a `Value` with respect to a `Seed`
+template <class Value, class Seed>
+using partial_t = decltype(std::declval<const Value&>() / std::declval<const Seed&>());
+
+/// @brief A dual number for forward-mode automatic differentiation of unit containers
+/// @tparam Value unit container of the value
+/// @tparam Seeds unit containers of the independent variables
+/// @note The tangent holds the partial derivative of the value with respect to each independent
+/// variable, each with the unit of the value divided by the unit of the variable. Functions
+/// written generically over the element types of `state_space::vector`s evaluate their Jacobian
+/// in a single call when called with vectors of duals.
+/// @note Overloads of `sin`, `cos`, `tan` and `atan` are provided in `units::math`, so functions
+/// calling these with qualified names may be differentiated. This header must be included
+/// before such functions are defined.
+template <class Value, class... Seeds>
+class dual {
+  public:
+    using value_type = Value;
+    using tangent_type = std::tuple<partial_t<Value, Seeds>...>;
+
+    static constexpr std::size_t seeds = sizeof...(Seeds);
+
+    constexpr dual() = default;
+    constexpr dual(const dual&) = default;
+    constexpr dual(dual&&) = default;
+
+    /// A constant with a tangent of zero
+    template <class T, class = std::enable_if_t<std::is_convertible<T, Value>::value>>
+    constexpr dual(const T& value) : value_{value}, tangent_{}
+    {}
+
+    constexpr dual(const Value& value, const tangent_type& tangent)
+        : value_{value}, tangent_{tangent}
+    {}
+
+    template <class T,
+              class = std::enable_if_t<std::is_convertible<T, Value>::value &&
+                                       !std::is_same<T, Value>::value>>
+    constexpr dual(const dual<T, Seeds...>& other)
+        : value_{other.value()}, tangent_{other.tangent()}
+    {}
+
+    /// @note `std::tuple` assignment is not `constexpr` until C++20 so partial derivatives are
+    /// assigned individually, allowing reassignment within constant expressions.
+    constexpr auto operator=(const dual& other) -> dual&
+    {
+        value_ = other.value_;
+        assign_tangent(other.tangent_, std::index_sequence_for<Seeds...>{});
+
+        return *this;
+    }
+
+    /// The independent variable with index `seed`
+    static constexpr auto variable(const Value& value, std::size_t seed) -> dual
+    {
+        return {value, unit_tangent(seed, std::index_sequence_for<Seeds...>{})};
+    }
+
+    constexpr auto value() const -> const Value& { return value_; }
+
+    constexpr auto tangent() const -> const tangent_type& { return tangent_; }
+
+    /// Partial derivative with respect to the independent variable with index `I`
+    template <std::size_t I>
+    constexpr auto partial() const -> const std::tuple_element_t<I, tangent_type>&
+    {
+        return std::get<I>(tangent_);
+    }
+
+    template <class T>
+    constexpr auto operator+=(const T& other) -> dual&
+    {
+        return *this = *this + other;
+    }
+
+    template <class T>
+    constexpr auto operator-=(const T& other) -> dual&
+    {
+        return *this = *this - other;
+    }
+
+    template <class T>
+    constexpr auto operator*=(const T& other) -> dual&
+    {
+        return *this = *this * other;
+    }
+
+    template <class T>
+    constexpr auto operator/=(const T& other) -> dual&
+    {
+        return *this = *this / other;
+    }
+
+  private:
+    template <std::size_t... Is>
+    constexpr auto assign_tangent(const tangent_type& other, std::index_sequence<Is...>) -> void
+    {
+        const auto unused = {(std::get<Is>(tangent_) = std::get<Is>(other), 0)...};
+        (void)unused;
+    }
+
+    template <std::size_t... Is>
+    static constexpr auto unit_tangent(std::size_t seed, std::index_sequence<Is...>)
+        -> tangent_type
+    {
+        return tangent_type{std::tuple_element_t<Is, tangent_type>(Is == seed ? 1 : 0)...};
+    }
+
+    Value value_{};
+    tangent_type tangent_{};
+};
+
+template <class T>
+struct is_dual : std::false_type {};
+
+template <class Value, class... Seeds>
+struct is_dual<dual<Value, Seeds...>> : std::true_type {};
+
+namespace detail {
+
+template <class T>
+using enable_if_constant = std::enable_if_t<!is_dual<T>::value>;
+
+template <class T>
+constexpr auto primal(const T& x) -> const T&
+{
+    return x;
+}
+
+template <class Value, class... Seeds>
+constexpr auto primal(const dual<Value, Seeds...>& x) -> const Value&
+{
+    return x.value();
+}
+
+/// Result of a function of one dual, given its value and its derivative with respect to `a`
+template <class Result, class Derivative, class Value, class... Seeds, std::size_t... Is>
+constexpr auto chain(const Result& value,
+                     const Derivative& da,
+                     const dual<Value, Seeds...>& a,
+                     std::index_sequence<Is...>) -> dual<Result, Seeds...>
+{
+    using tangent_type = typename dual<Result, Seeds...>::tangent_type;
+
+    return {value, tangent_type{(a.template partial<Is>() * da)...}};
+}
+
+template <class Result, class Derivative, class Value, class... Seeds>
+constexpr auto chain(const Result& value, const Derivative& da, const dual<Value, Seeds...>& a)
+    -> dual<Result, Seeds...>
+{
+    return chain(value, da, a, std::index_sequence_for<Seeds...>{});
+}
+
+/// Result of a function of two duals, given its value and its derivatives with respect to `a`
+/// and `b`
+template <class Result,
+          class DerivativeA,
+          class ValueA,
+          class DerivativeB,
+          class ValueB,
+          class... Seeds,
+          std::size_t... Is>
+constexpr auto chain(const Result& value,
+                     const DerivativeA& da,
+                     const dual<ValueA, Seeds...>& a,
+                     const DerivativeB& db,
+                     const dual<ValueB, Seeds...>& b,
+                     std::index_sequence<Is...>) -> dual<Result, Seeds...>
+{
+    using tangent_type = typename dual<Result, Seeds...>::tangent_type;
+
+    return {value,
+            tangent_type{(a.template partial<Is>() * da + b.template partial<Is>() * db)...}};
+}
+
+template <class ValueA, class ValueB, class... Seeds, std::size_t... Is>
+constexpr auto
+add(const dual<ValueA, Seeds...>& a, const dual<ValueB, Seeds...>& b, std::index_sequence<Is...>)
+{
+    using result_type = dual<std::decay_t<decltype(a.value() + b.value())>, Seeds...>;
+    using tangent_type = typename result_type::tangent_type;
+
+    return result_type{a.value() + b.value(),
+                       tangent_type{(a.template partial<Is>() + b.template partial<Is>())...}};
+}
+
+template <class ValueA, class ValueB, class... Seeds, std::size_t... Is>
+constexpr auto subtract(const dual<ValueA, Seeds...>& a,
+                        const dual<ValueB, Seeds...>& b,
+                        std::index_sequence<Is...>)
+{
+    using result_type = dual<std::decay_t<decltype(a.value() - b.value())>, Seeds...>;
+    using tangent_type = typename result_type::tangent_type;
+
+    return result_type{a.value() - b.value(),
+                       tangent_type{(a.template partial<Is>() - b.template partial<Is>())...}};
+}
+
+template <class Value, class... Seeds, std::size_t... Is>
+constexpr auto negate(const dual<Value, Seeds...>& a, std::index_sequence<Is...>)
+    -> dual<Value, Seeds...>
+{
+    using tangent_type = typename dual<Value, Seeds...>::tangent_type;
+
+    return {-a.value(), tangent_type{(-a.template partial<Is>())...}};
+}
+
+/// Derivatives of elementary functions, evaluating the functions of values with `Math`
+template <class Math>
+struct elementary {
+    template <class Value, class... Seeds>
+    static constexpr auto sin(const dual<Value, Seeds...>& a)
+    {
+        return chain(Math::sin(a.value()), Math::cos(a.value()) / radian(), a);
+    }
+
+    template <class Value, class... Seeds>
+    static constexpr auto cos(const dual<Value, Seeds...>& a)
+    {
+        return chain(Math::cos(a.value()), -Math::sin(a.value()) / radian(), a);
+    }
+
+    template <class Value, class... Seeds>
+    static constexpr auto tan(const dual<Value, Seeds...>& a)
+    {
+        const auto c = Math::cos(a.value());
+
+        return chain(Math::tan(a.value()), scalar(1) / (c * c) / radian(), a);
+    }
+
+    template <class Value, class... Seeds>
+    static constexpr auto atan(const dual<Value, Seeds...>& a)
+    {
+        const auto x = scalar(a.value());
+
+        return chain(Math::atan(a.value()), radian() / (scalar(1) + x * x), a);
+    }
+
+  private:
+    static constexpr auto radian() -> units::angle::radian_t { return units::angle::radian_t(1); }
+
+    template <class T>
+    static constexpr auto scalar(const T& x) -> units::dimensionless::scalar_t
+    {
+        return units::dimensionless::scalar_t(x);
+    }
+};
+
+struct units_math {
+    template <class Angle>
+    static auto sin(const Angle& t)
+    {
+        return units::math::sin(t);
+    }
+
+    template <class Angle>
+    static auto cos(const Angle& t)
+    {
+        return units::math::cos(t);
+    }
+
+    template <class Angle>
+    static auto tan(const Angle& t)
+    {
+        return units::math::tan(t);
+    }
+
+    template <class Scalar>
+    static auto atan(const Scalar& s)
+    {
+        return units::math::atan(s);
+    }
+};
+
+}  // namespace detail
+
+template <class ValueA, class ValueB, class... Seeds>
+constexpr auto operator+(const dual<ValueA, Seeds...>& a, const dual<ValueB, Seeds...>& b)
+{
+    return detail::add(a, b, std::index_sequence_for<Seeds...>{});
+}
+
+template <class Value, class... Seeds, class T, class = detail::enable_if_constant<T>>
+constexpr auto operator+(const dual<Value, Seeds...>& a, const T& c)
+{
+    using result_type = dual<std::decay_t<decltype(a.value() + c)>, Seeds...>;
+
+    return result_type{a.value() + c, a.tangent()};
+}
+
+template <class T, class Value, class... Seeds, class = detail::enable_if_constant<T>>
+constexpr auto operator+(const T& c, const dual<Value, Seeds...>& b)
+{
+    using result_type = dual<std::decay_t<decltype(c + b.value())>, Seeds...>;
+
+    return result_type{c + b.value(), b.tangent()};
+}
+
+template <class Value, class... Seeds>
+constexpr auto operator+(const dual<Value, Seeds...>& a) -> dual<Value, Seeds...>
+{
+    return a;
+}
+
+template <class ValueA, class ValueB, class... Seeds>
+constexpr auto operator-(const dual<ValueA, Seeds...>& a, const dual<ValueB, Seeds...>& b)
+{
+    return detail::subtract(a, b, std::index_sequence_for<Seeds...>{});
+}
+
+template <class Value, class... Seeds, class T, class = detail::enable_if_constant<T>>
+constexpr auto operator-(const dual<Value, Seeds...>& a, const T& c)
+{
+    using result_type = dual<std::decay_t<decltype(a.value() - c)>, Seeds...>;
+
+    return result_type{a.value() - c, a.tangent()};
+}
+
+template <class T, class Value, class... Seeds, class = detail::enable_if_constant<T>>
+constexpr auto operator-(const T& c, const dual<Value, Seeds...>& b)
+{
+    return c + -b;
+}
+
+template <class Value, class... Seeds>
+constexpr auto operator-(const dual<Value, Seeds...>& a) -> dual<Value, Seeds...>
+{
+    return detail::negate(a, std::index_sequence_for<Seeds...>{});
+}
+
+template <class ValueA, class ValueB, class... Seeds>
+constexpr auto operator*(const dual<ValueA, Seeds...>& a, const dual<ValueB, Seeds...>& b)
+{
+    return detail::chain(a.value() * b.value(), b.value(), a, a.value(), b,
+                         std::index_sequence_for<Seeds...>{});
+}
+
+template <class Value, class... Seeds, class T, class = detail::enable_if_constant<T>>
+constexpr auto operator*(const dual<Value, Seeds...>& a, const T& c)
+{
+    return detail::chain(a.value() * c, c, a);
+}
+
+template <class T, class Value, class... Seeds, class = detail::enable_if_constant<T>>
+constexpr auto operator*(const T& c, const dual<Value, Seeds...>& b)
+{
+    return detail::chain(c * b.value(), c, b);
+}
+
+template <class ValueA, class ValueB, class... Seeds>
+constexpr auto operator/(const dual<ValueA, Seeds...>& a, const dual<ValueB, Seeds...>& b)
+{
+    const auto q = a.value() / b.value();
+
+    return detail::chain(q, 1 / b.value(), a, -q / b.value(), b,
+                         std::index_sequence_for<Seeds...>{});
+}
+
+template <class Value, class... Seeds, class T, class = detail::enable_if_constant<T>>
+constexpr auto operator/(const dual<Value, Seeds...>& a, const T& c)
+{
+    return detail::chain(a.value() / c, 1 / c, a);
+}
+
+template <class T, class Value, class... Seeds, class = detail::enable_if_constant<T>>
+constexpr auto operator/(const T& c, const dual<Value, Seeds...>& b)
+{
+    const auto q = c / b.value();
+
+    return detail::chain(q, -q / b.value(), b);
+}
+
+/// @note Comparisons only consider values.
+template <class A, class B, class = std::enable_if_t<is_dual<A>::value || is_dual<B>::value>>
+constexpr auto operator==(const A& a, const B& b) -> bool
+{
+    return detail::primal(a) == detail::primal(b);
+}
+
+template <class A, class B, class = std::enable_if_t<is_dual<A>::value || is_dual<B>::value>>
+constexpr auto operator!=(const A& a, const B& b) -> bool
+{
+    return detail::primal(a) != detail::primal(b);
+}
+
+template <class A, class B, class = std::enable_if_t<is_dual<A>::value || is_dual<B>::value>>
+constexpr auto operator<(const A& a, const B& b) -> bool
+{
+    return detail::primal(a) < detail::primal(b);
+}
+
+template <class A, class B, class = std::enable_if_t<is_dual<A>::value || is_dual<B>::value>>
+constexpr auto operator>(const A& a, const B& b) -> bool
+{
+    return detail::primal(a) > detail::primal(b);
+}
+
+template <class A, class B, class = std::enable_if_t<is_dual<A>::value || is_dual<B>::value>>
+constexpr auto operator<=(const A& a, const B& b) -> bool
+{
+    return detail::primal(a) <= detail::primal(b);
+}
+
+template <class A, class B, class = std::enable_if_t<is_dual<A>::value || is_dual<B>::value>>
+constexpr auto operator>=(const A& a, const B& b) -> bool
+{
+    return detail::primal(a) >= detail::primal(b);
+}
+
+template <class Value, class... Seeds>
+auto operator<<(std::ostream& os, const dual<Value, Seeds...>& a) -> std::ostream&
+{
+    return os << a.value();
+}
+
+}  // namespace autodiff
+
+namespace state_space {
+
+template <class Value, class... Seeds>
+struct value_traits<autodiff::dual<Value, Seeds...>> : std::true_type {
+    using unit_type = typename value_traits<Value>::unit_type;
+
+    template <class Unit>
+    using rebind =
+        autodiff::dual<typename value_traits<Value>::template rebind<Unit>, Seeds...>;
+};
+
+}  // namespace state_space
+}  // namespace ode
+
+namespace units {
+namespace math {
+
+template <class Value, class... Seeds>
+auto sin(const ode::autodiff::dual<Value, Seeds...>& a)
+{
+    return ode::autodiff::detail::elementary<ode::autodiff::detail::units_math>::sin(a);
+}
+
+template <class Value, class... Seeds>
+auto cos(const ode::autodiff::dual<Value, Seeds...>& a)
+{
+    return ode::autodiff::detail::elementary<ode::autodiff::detail::units_math>::cos(a);
+}
+
+template <class Value, class... Seeds>
+auto tan(const ode::autodiff::dual<Value, Seeds...>& a)
+{
+    return ode::autodiff::detail::elementary<ode::autodiff::detail::units_math>::tan(a);
+}
+
+template <class Value, class... Seeds>
+auto atan(const ode::autodiff::dual<Value, Seeds...>& a)
+{
+    return ode::autodiff::detail::elementary<ode::autodiff::detail::units_math>::atan(a);
+}
+
+}  // namespace math
+}  // namespace units
@@ -0,0 +1,179 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <limits>
+#include <utility>
+
+namespace ode {
+
+/// Direction of a zero crossing of an event function
+enum class event_direction { rising, falling, either };
+
+/// Whether integration continues after an event
+enum class event_action { resume, terminate };
+
+/// Ends integration at the state where an event occurs
+struct terminate_integration {
+    template <class Time, class State, class Input>
+    constexpr auto operator()(Time, const State&, Input&) const noexcept -> event_action
+    {
+        return event_action::terminate;
+    }
+};
+
+/// Replaces the input at the state where an event occurs and resumes integration
+template <class Input>
+struct switch_input {
+    template <class Time, class State>
+    constexpr auto operator()(Time, const State&, Input& u) const -> event_action
+    {
+        u = input;
+        return event_action::resume;
+    }
+
+    Input input;
+};
+
+template <class Input>
+constexpr auto make_switch_input(Input u)
+{
+    return switch_input<Input>{std::move(u)};
+}
+
+/// @brief Zero crossing of a function of the state
+/// @tparam Function callable as `g(x)`, returning a scalar or a unit of any dimension
+/// @tparam Action callable as `a(t, x, u)` with the time and state of the crossing and a mutable
+/// reference to the input, returning an `event_action`
+/// @note A crossing is located to within `tolerance`.
+template <class Function, class Action>
+struct event {
+    Function function;
+    event_direction direction;
+    Action action;
+    std::chrono::duration<double> tolerance;
+};
+
+template <class Function, class Action = terminate_integration>
+constexpr auto make_event(Function g,
+                          event_direction direction = event_direction::either,
+                          Action action = {},
+                          std::chrono::duration<double> tolerance = std::chrono::microseconds{1})
+{
+    return event<Function, Action>{std::move(g), direction, std::move(action), tolerance};
+}
+
+namespace detail {
+
+/// Value of an event function as a `double`, in the unit of the function
+template <class Value>
+constexpr auto event_value(const Value& v) -> double
+{
+    return static_cast<double>(v / Value{1});
+}
+
+/// True if the value of an event function crosses zero in `direction` from `v0` to `v1`
+constexpr auto event_crossed(event_direction direction, double v0, double v1) noexcept -> bool
+{
+    const auto rising = (v0 < 0.0) && (v1 >= 0.0);
+    const auto falling = (v0 > 0.0) && (v1 <= 0.0);
+
+    return (direction == event_direction::rising)    ? rising
+           : (direction == event_direction::falling) ? falling
+                                                     : (rising || falling);
+}
+
+/// @brief Locates a zero crossing of `f` on [0, 1] by Brent's method, given `f(0) = f0` and
+/// `f(1) = f1` of opposite sign or with `f1` zero
+/// @return the end of the final bracket, no wider than `tolerance`, with the sign of `f1`
+/// Brent 1973 Algorithms for Minimization without Derivatives, Chapter 4
+template <class Function>
+auto locate_crossing(Function f, double f0, double f1, double tolerance) -> double
+{
+    constexpr auto max_iterations = 100;
+    constexpr auto eps = std::numeric_limits<double>::epsilon();
+
+    if (f1 == 0.0) {
+        return 1.0;
+    }
+
+    // `b` is the best estimate of the crossing and `c` the other end of the bracket
+    auto a = 0.0;
+    auto b = 1.0;
+    auto c = 0.0;
+    auto fa = f0;
+    auto fb = f1;
+    auto fc = f0;
+    auto d = b - a;
+    auto e = d;
+
+    for (auto i = 0; i < max_iterations; ++i) {
+        if ((fb > 0.0) == (fc > 0.0)) {
+            c = a;
+            fc = fa;
+            d = b - a;
+            e = d;
+        }
+
+        if (std::fabs(fc) < std::fabs(fb)) {
+            a = b;
+            b = c;
+            c = a;
+            fa = fb;
+            fb = fc;
+            fc = fa;
+        }
+
+        const auto tol = 2.0 * eps * std::fabs(b) + 0.5 * tolerance;
+        const auto m = 0.5 * (c - b);
+
+        if ((std::fabs(m) <= tol) || (fb == 0.0)) {
+            break;
+        }
+
+        if ((std::fabs(e) >= tol) && (std::fabs(fa) > std::fabs(fb))) {
+            // Inverse quadratic interpolation, or the secant method with two points
+            const auto s = fb / fa;
+            auto p = 0.0;
+            auto q = 0.0;
+            if (a == c) {
+                p = 2.0 * m * s;
+                q = 1.0 - s;
+            } else {
+                const auto qa = fa / fc;
+                const auto r = fb / fc;
+                p = s * (2.0 * m * qa * (qa - r) - (b - a) * (r - 1.0));
+                q = (qa - 1.0) * (r - 1.0) * (s - 1.0);
+            }
+
+            if (p > 0.0) {
+                q = -q;
+            } else {
+                p = -p;
+            }
+
+            if (2.0 * p < std::min(3.0 * m * q - std::fabs(tol * q), std::fabs(e * q))) {
+                e = d;
+                d = p / q;
+            } else {
+                d = m;
+                e = d;
+            }
+        } else {
+            // Bisection
+            d = m;
+            e = d;
+        }
+
+        a = b;
+        fa = fb;
+        b += (std::fabs(d) > tol) ? d : ((m > 0.0) ? tol : -tol);
+        fb = f(b);
+    }
+
+    return ((fb == 0.0) || ((fb > 0.0) == (f1 > 0.0))) ? b : c;
+}
+
+}  // namespace detail
+}  // namespace ode
@@ -1,40 +1,369 @@
 #pragma once
 
 #include "gcem.hpp"
+#include "ode/autodiff.h"
 #include "units.h"
 
+#include <cmath>
+#include <limits>
+
+#if defined(__has_builtin)
+#if __has_builtin(__builtin_is_constant_evaluated)
+#define ODE_MATH_HAS_IS_CONSTANT_EVALUATED
+#endif
+#elif defined(__GNUC__) && (__GNUC__ >= 9)
+#define ODE_MATH_HAS_IS_CONSTANT_EVALUATED
+#endif
+
 namespace ode {
 namespace math {
 
-template <class AngleUnit>
+namespace detail {
+
+/// True if evaluated within a constant expression. Without compiler support, always true.
+constexpr auto is_constant_evaluated() noexcept -> bool
+{
+#ifdef ODE_MATH_HAS_IS_CONSTANT_EVALUATED
+    return __builtin_is_constant_evaluated();
+#else
+    return true;
+#endif
+}
+
+}  // namespace detail
+
+/// @brief Evaluates functions with `gcem` in constant expressions and with the standard library
+/// at run time
+/// @note Results may differ in the last bits between the two. If the compiler cannot detect
+/// constant evaluation, functions are always evaluated with `gcem`.
+struct standard {
+    template <class T>
+    static constexpr auto sin(T x) noexcept -> T
+    {
+        return detail::is_constant_evaluated() ? gcem::sin(x) : std::sin(x);
+    }
+
+    template <class T>
+    static constexpr auto cos(T x) noexcept -> T
+    {
+        return detail::is_constant_evaluated() ? gcem::cos(x) : std::cos(x);
+    }
+
+    template <class T>
+    static constexpr auto tan(T x) noexcept -> T
+    {
+        return detail::is_constant_evaluated() ? gcem::tan(x) : std::tan(x);
+    }
+
+    template <class T>
+    static constexpr auto atan(T x) noexcept -> T
+    {
+        return detail::is_constant_evaluated() ? gcem::atan(x) : std::atan(x);
+    }
+};
+
+/// @brief Evaluates functions with `gcem` in constant expressions and at run time, giving
+/// identical results in both
+struct compile_time {
+    template <class T>
+    static constexpr auto sin(T x) noexcept -> T
+    {
+        return gcem::sin(x);
+    }
+
+    template <class T>
+    static constexpr auto cos(T x) noexcept -> T
+    {
+        return gcem::cos(x);
+    }
+
+    template <class T>
+    static constexpr auto tan(T x) noexcept -> T
+    {
+        return gcem::tan(x);
+    }
+
+    template <class T>
+    static constexpr auto atan(T x) noexcept -> T
+    {
+        return gcem::atan(x);
+    }
+};
+
+namespace detail {
+
+constexpr auto factorial(int n) -> double
+{
+    auto f = 1.0;
+    for (auto i = 2; i <= n; ++i) {
+        f *= i;
+    }
+    return f;
+}
+
+/// Truncated Taylor series of sine divided by x, in powers of x^2 on [-pi/4, pi/4]
+struct sin_series {
+    static constexpr auto power(int k) -> int { return 2 * k + 1; }
+
+    static constexpr auto divisor(int k) -> double { return factorial(power(k)); }
+
+    static constexpr auto bound() -> double { return 0.78539816339744831; }
+};
+
+/// Truncated Taylor series of cosine, in powers of x^2 on [-pi/4, pi/4]
+struct cos_series {
+    static constexpr auto power(int k) -> int { return 2 * k; }
+
+    static constexpr auto divisor(int k) -> double { return factorial(power(k)); }
+
+    static constexpr auto bound() -> double { return 0.78539816339744831; }
+};
+
+/// Truncated Taylor series of arctangent divided by x, in powers of x^2 on
+/// [-tan(pi/12), tan(pi/12)]
+struct atan_series {
+    static constexpr auto power(int k) -> int { return 2 * k + 1; }
+
+    static constexpr auto divisor(int k) -> double { return power(k); }
+
+    static constexpr auto bound() -> double { return 0.26794919243112270; }
+};
+
+/// Number of terms of an alternating series such that the first omitted term, which bounds the
+/// truncation error, is less than `10^-digits` everywhere on the range of the series
+template <class Series>
+constexpr auto series_terms(int digits) -> int
+{
+    auto tolerance = 1.0;
+    for (auto i = 0; i < digits; ++i) {
+        tolerance /= 10;
+    }
+
+    auto n = 0;
+    for (;;) {
+        auto magnitude = 1.0 / Series::divisor(n);
+        for (auto i = 0; i < Series::power(n); ++i) {
+            magnitude *= Series::bound();
+        }
+
+        if (magnitude < tolerance) {
+            return n;
+        }
+        ++n;
+    }
+}
+
+/// Evaluates the series from term `K` with `N` remaining terms in `z = x^2` by Horner's method
+template <class T, class Series, int K, int N>
+struct horner {
+    static constexpr auto evaluate(T z) noexcept -> T
+    {
+        constexpr auto c = static_cast<T>(((K % 2 == 0) ? 1.0 : -1.0) / Series::divisor(K));
+        return c + z * horner<T, Series, K + 1, N - 1>::evaluate(z);
+    }
+};
+
+template <class T, class Series, int K>
+struct horner<T, Series, K, 1> {
+    static constexpr auto evaluate(T) noexcept -> T
+    {
+        return static_cast<T>(((K % 2 == 0) ? 1.0 : -1.0) / Series::divisor(K));
+    }
+};
+
+template <class T, class Series, int Digits>
+constexpr auto series(T z) noexcept -> T
+{
+    return horner<T, Series, 0, series_terms<Series>(Digits)>::evaluate(z);
+}
+
+/// Sine and cosine of an angle reduced to [-pi/4, pi/4] and the quadrant of the angle
+template <class T>
+struct reduced_angle {
+    T sin;
+    T cos;
+    int quadrant;
+};
+
+template <class T, int Digits>
+constexpr auto reduce(T x) noexcept -> reduced_angle<T>
+{
+    // pi/2 split into parts, the first two of which have few enough significant bits for their
+    // products with the quadrant to be exact in single precision
+    constexpr auto pio2_1 = static_cast<T>(1.5703125);
+    constexpr auto pio2_2 = static_cast<T>(4.837512969970703125e-4);
+    constexpr auto pio2_3 = static_cast<T>(7.54978995489188216916e-8);
+    constexpr auto two_over_pi = static_cast<T>(0.63661977236758134308);
+
+    // beyond this a quadrant overflows the conversion to `int` or the spacing of `T` exceeds one,
+    // so that the reduced angle is meaningless
+    constexpr auto max_quadrant =
+        static_cast<T>(1L << ((std::numeric_limits<T>::digits - 1 < 30)
+                                  ? std::numeric_limits<T>::digits - 1
+                                  : 30));
+
+    // false for NaN and infinite arguments, which are reduced to NaN
+    const auto q = x * two_over_pi;
+    const auto in_range = (q < max_quadrant) && (-max_quadrant < q);
+
+    const auto k = static_cast<int>(in_range ? q + ((x < T{0}) ? T{-0.5} : T{0.5}) : T{0});
+    const auto kt = static_cast<T>(k);
+    const auto r = in_range ? ((x - kt * pio2_1) - kt * pio2_2) - kt * pio2_3
+                            : std::numeric_limits<T>::quiet_NaN();
+    const auto z = r * r;
+
+    return {r * series<T, sin_series, Digits>(z), series<T, cos_series, Digits>(z), k & 3};
+}
+
+}  // namespace detail
+
+/// @brief Evaluates functions as truncated polynomials, with an absolute error less than
+/// `10^-Digits` for `sin`, `cos` and `atan` in addition to the rounding error of `T`
+/// @note Functions are constant expressions and free of calls and, apart from selecting the
+/// quadrant, branches, so loops over them may be vectorized. Error grows with the magnitude of
+/// an angle as reducing it to [-pi/4, pi/4] loses precision. `sin`, `cos` and `tan` of angles
+/// beyond 2^30 pi/2 (about 1.7e9) in double precision or 2^23 pi/2 (about 1.3e7) in single
+/// precision, and of non-finite angles, are NaN. `tan` is the ratio of `sin` and `cos` and its
+/// relative error grows near its poles.
+template <int Digits>
+struct polynomial {
+    static_assert(Digits > 0 && Digits <= 15,
+                  "A polynomial approximation requires between 1 and 15 digits.");
+
+    template <class T>
+    static constexpr auto sin(T x) noexcept -> T
+    {
+        const auto a = detail::reduce<T, Digits>(x);
+        const auto s = (a.quadrant & 1) ? a.cos : a.sin;
+        return (a.quadrant & 2) ? -s : s;
+    }
+
+    template <class T>
+    static constexpr auto cos(T x) noexcept -> T
+    {
+        const auto a = detail::reduce<T, Digits>(x);
+        const auto c = (a.quadrant & 1) ? a.sin : a.cos;
+        return ((a.quadrant + 1) & 2) ? -c : c;
+    }
+
+    template <class T>
+    static constexpr auto tan(T x) noexcept -> T
+    {
+        const auto a = detail::reduce<T, Digits>(x);
+        return (a.quadrant & 1) ? -a.cos / a.sin : a.sin / a.cos;
+    }
+
+    template <class T>
+    static constexpr auto atan(T x) noexcept -> T
+    {
+        constexpr auto pi_2 = static_cast<T>(1.57079632679489661923);
+        constexpr auto pi_6 = static_cast<T>(0.52359877559829887308);
+        constexpr auto sqrt3 = static_cast<T>(1.73205080756887729353);
+        constexpr auto tan_pi_12 = static_cast<T>(detail::atan_series::bound());
+
+        // atan(x) = pi/2 - atan(1/x) and atan(x) = pi/6 + atan((sqrt(3) x - 1) / (x + sqrt(3)))
+        const auto a = (x < T{0}) ? -x : x;
+        const auto invert = a > T{1};
+        const auto y = invert ? T{1} / a : a;
+        const auto shift = y > tan_pi_12;
+        const auto t = shift ? (sqrt3 * y - T{1}) / (y + sqrt3) : y;
+
+        const auto r = t * detail::series<T, detail::atan_series, Digits>(t * t) +
+                       (shift ? pi_6 : T{0});
+        const auto v = invert ? pi_2 - r : r;
+
+        return (x < T{0}) ? -v : v;
+    }
+};
+
+/// @brief Trigonometric functions of unit containers
+/// @tparam Policy evaluating functions of underlying values, one of `standard`,
+/// `compile_time` or `polynomial`
+template <class Policy = standard>
+struct functions;
+
+template <class Policy = standard, class AngleUnit>
 constexpr auto sin(const AngleUnit angle) noexcept
 {
     static_assert(units::traits::is_angle_unit<AngleUnit>::value, "");
     return units::dimensionless::scalar_t(
-        gcem::sin(angle.template convert<units::angle::radian>().value()));
+        Policy::sin(angle.template convert<units::angle::radian>().value()));
 }
 
-template <class AngleUnit>
+template <class Policy = standard, class AngleUnit>
 constexpr auto cos(const AngleUnit angle) noexcept
 {
     static_assert(units::traits::is_angle_unit<AngleUnit>::value, "");
     return units::dimensionless::scalar_t(
-        gcem::cos(angle.template convert<units::angle::radian>().value()));
+        Policy::cos(angle.template convert<units::angle::radian>().value()));
 }
 
-template <class AngleUnit>
+template <class Policy = standard, class AngleUnit>
 constexpr auto tan(const AngleUnit angle) noexcept
 {
     static_assert(units::traits::is_angle_unit<AngleUnit>::value, "");
     return units::dimensionless::scalar_t(
-        gcem::tan(angle.template convert<units::angle::radian>().value()));
+        Policy::tan(angle.template convert<units::angle::radian>().value()));
 }
 
-template <class ScalarUnit>
+template <class Policy = standard, class ScalarUnit>
 constexpr auto atan(const ScalarUnit x) noexcept
 {
     static_assert(units::traits::is_dimensionless_unit<ScalarUnit>::value, "");
-    return units::angle::radian_t(gcem::atan(x.value()));
+    return units::angle::radian_t(Policy::atan(x.value()));
+}
+
+/// @note May be passed as the math policy of a transition function, selecting how all of its
+/// trigonometric functions are evaluated.
+template <class Policy>
+struct functions {
+    template <class Angle>
+    static constexpr auto sin(const Angle& t)
+    {
+        return math::sin<Policy>(t);
+    }
+
+    template <class Angle>
+    static constexpr auto cos(const Angle& t)
+    {
+        return math::cos<Policy>(t);
+    }
+
+    template <class Angle>
+    static constexpr auto tan(const Angle& t)
+    {
+        return math::tan<Policy>(t);
+    }
+
+    template <class Scalar>
+    static constexpr auto atan(const Scalar& s)
+    {
+        return math::atan<Policy>(s);
+    }
+};
+
+template <class Policy = standard, class Value, class... Seeds>
+constexpr auto sin(const autodiff::dual<Value, Seeds...>& a)
+{
+    return autodiff::detail::elementary<functions<Policy>>::sin(a);
+}
+
+template <class Policy = standard, class Value, class... Seeds>
+constexpr auto cos(const autodiff::dual<Value, Seeds...>& a)
+{
+    return autodiff::detail::elementary<functions<Policy>>::cos(a);
+}
+
+template <class Policy = standard, class Value, class... Seeds>
+constexpr auto tan(const autodiff::dual<Value, Seeds...>& a)
+{
+    return autodiff::detail::elementary<functions<Policy>>::tan(a);
+}
+
+template <class Policy = standard, class Value, class... Seeds>
+constexpr auto atan(const autodiff::dual<Value, Seeds...>& a)
+{
+    return autodiff::detail::elementary<functions<Policy>>::atan(a);
 }
 
 }  // namespace math
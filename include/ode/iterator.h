@@ -1,11 +1,18 @@
 #pragma once
 
+#include "ode/event.h"
+#include "ode/observer.h"
 #include "ode/stepper.h"
 #include "ode/tmp/type_traits.h"
 
+#include <algorithm>
+#include <array>
 #include <chrono>
+#include <cstddef>
 #include <functional>
 #include <iterator>
+#include <new>
+#include <tuple>
 #include <utility>
 
 namespace ode {
@@ -24,8 +31,180 @@ constexpr auto adapt_rangepair(std::pair<Iterator, Iterator> rp)
     return range{rp.first, rp.second};
 }
 
-template <class Stepper, class System, class State, class StepDuration>
-class owning_step_iterator {
+/// @brief End of a step range, reached once the iterator compared with it has elapsed its span
+/// @note Holds no system or state, so that comparing with it is a single check of the elapsed
+/// time.
+struct step_sentinel {};
+
+namespace detail {
+
+/// @brief Range of the states of an owning iterator, ending at a `step_sentinel`
+/// @note A range-based for loop accepts an end of a different type than its begin from C++17.
+/// Before C++17 the range ends at a default-constructed `Iterator`, which holds no system and has
+/// no span left.
+template <class Iterator>
+struct sentinel_range {
+    Iterator begin_;
+
+    constexpr auto begin() const -> Iterator { return begin_; }
+
+#if __cpp_range_based_for >= 201603L
+    constexpr auto end() const noexcept -> step_sentinel { return {}; }
+#else
+    constexpr auto end() const -> Iterator { return Iterator{}; }
+#endif
+};
+
+/// @brief Range of wrappers of the iterators of `Range`, such as a `strided_iterator`
+/// @note `Range` is a reference for an lvalue range and a value for an rvalue range. The begin
+/// is wrapped when `begin` is called, and a `step_sentinel` end is not wrapped.
+template <class Wrapper, class Range, class Arg>
+class wrapped_range {
+  public:
+    constexpr wrapped_range(Range&& range, Arg arg)
+        : range_{std::forward<Range>(range)}, arg_{arg}
+    {}
+
+    constexpr auto begin() -> Wrapper
+    {
+        return Wrapper{std::begin(range_), std::end(range_), arg_};
+    }
+
+    constexpr auto end() { return wrap_end(std::end(range_)); }
+
+  private:
+    template <class Iterator>
+    constexpr auto wrap_end(Iterator last) -> Wrapper
+    {
+        return Wrapper{last, last, arg_};
+    }
+
+    constexpr auto wrap_end(step_sentinel) noexcept -> step_sentinel { return {}; }
+
+    Range range_;
+    Arg arg_;
+};
+
+/// @brief Holds a value, or no value in the end iterator of a range, which is never dereferenced
+/// or incremented
+/// @note Unlike a default-constructed value, an empty holder does not require `T` to be default
+/// constructible and constructs nothing.
+template <class T>
+class end_or_value {
+  public:
+    end_or_value() noexcept : empty_{} {}
+
+    explicit end_or_value(T value) : value_{std::move(value)}, engaged_{true} {}
+
+    end_or_value(const end_or_value& other) : empty_{}
+    {
+        if (other.engaged_) {
+            construct(other.value_);
+        }
+    }
+
+    end_or_value(end_or_value&& other) : empty_{}
+    {
+        if (other.engaged_) {
+            construct(std::move(other.value_));
+        }
+    }
+
+    auto operator=(const end_or_value& other) -> end_or_value&
+    {
+        if (this != &other) {
+            reset();
+            if (other.engaged_) {
+                construct(other.value_);
+            }
+        }
+        return *this;
+    }
+
+    auto operator=(end_or_value&& other) -> end_or_value&
+    {
+        if (this != &other) {
+            reset();
+            if (other.engaged_) {
+                construct(std::move(other.value_));
+            }
+        }
+        return *this;
+    }
+
+    ~end_or_value() { reset(); }
+
+    auto get() const noexcept -> const T& { return value_; }
+
+  private:
+    template <class U>
+    auto construct(U&& value) -> void
+    {
+        ::new (static_cast<void*>(&value_)) T(std::forward<U>(value));
+        engaged_ = true;
+    }
+
+    auto reset() noexcept -> void
+    {
+        if (engaged_) {
+            value_.~T();
+            engaged_ = false;
+        }
+    }
+
+    union {
+        char empty_;
+        T value_;
+    };
+    bool engaged_ = false;
+};
+
+}  // namespace detail
+
+namespace detail {
+
+/// Time and step size of a controlled stepper, which adapts the step size after each step
+template <class Stepper, class Tag>
+struct adaptive_step {};
+
+template <class Stepper>
+struct adaptive_step<Stepper, stepper::odeint_controlled_tag> {
+    typename Stepper::time_type t;
+    typename Stepper::time_type dt;
+};
+
+/// Converts a duration to the time type of an odeint stepper, a unit of time or seconds
+template <class Time, class Rep, class Period>
+constexpr auto to_stepper_time(std::chrono::duration<Rep, Period> d) -> Time
+{
+    return Time{std::chrono::duration<double>{d}.count()};
+}
+
+template <class Time>
+constexpr auto to_seconds(const Time& t) -> std::chrono::duration<double>
+{
+    return std::chrono::duration<double>{static_cast<double>(t / Time{1})};
+}
+
+}  // namespace detail
+
+/// @brief Iterates over states at the end of each step
+/// @tparam Stepper a state space stepper, an odeint stepper, or an odeint controlled or dense
+/// output stepper. The iterator owns a single instance for its lifetime, so steppers that keep
+/// history, such as `adams_bashforth_moulton`, and steppers configured with tolerances may be
+/// used.
+/// @tparam Observer receives the right-hand side evaluations and steps of the integration, such
+/// as a `counting_observer` or `trace_observer`, and is held by reference
+/// @note A controlled stepper visits the state after each accepted step, starting with a step of
+/// `step` and ending at `span`. The elapsed time of each state is rounded towards zero to
+/// `StepDuration`, which should be a floating-point duration for exact times. A dense output
+/// stepper takes steps of its own size and visits states interpolated every `step`.
+template <class Stepper,
+          class System,
+          class State,
+          class StepDuration,
+          class Observer = null_observer>
+class owning_step_iterator : private detail::observer_handle<Observer> {
     static_assert(tmp::is_specialization_of<StepDuration, std::chrono::duration>::value, "");
 
     using stepper_type = Stepper;
@@ -33,6 +212,9 @@ class owning_step_iterator {
     using state_type = State;
     using iterator_step_type = StepDuration;
 
+    // Held as a base so that the null observer takes no space
+    using observer_type = detail::observer_handle<Observer>;
+
   public:
     using iterator = owning_step_iterator;
 
@@ -43,28 +225,116 @@ class owning_step_iterator {
                                 std::add_lvalue_reference_t<state_type>>;
     using iterator_category = std::input_iterator_tag;
 
+    constexpr owning_step_iterator(stepper_type stepper,
+                                   system_type sys,
+                                   state_type x0,
+                                   iterator_step_type span,
+                                   iterator_step_type step,
+                                   Observer& observer)
+        : observer_type{observer},
+          stepper_{std::move(stepper)},
+          system_{std::move(sys)},
+          state_{std::move(x0)},
+          span_{span},
+          step_{step}
+    {
+        start(stepper::stepper_tag<Stepper>{});
+    }
+
+    template <class O = Observer, class = std::enable_if_t<std::is_same<O, null_observer>::value>>
+    constexpr owning_step_iterator(stepper_type stepper,
+                                   system_type sys,
+                                   state_type x0,
+                                   iterator_step_type span,
+                                   iterator_step_type step)
+        : stepper_{std::move(stepper)},
+          system_{std::move(sys)},
+          state_{std::move(x0)},
+          span_{span},
+          step_{step}
+    {
+        start(stepper::stepper_tag<Stepper>{});
+    }
+
+    constexpr owning_step_iterator(system_type sys,
+                                   state_type x0,
+                                   iterator_step_type span,
+                                   iterator_step_type step,
+                                   Observer& observer)
+        : owning_step_iterator{
+              stepper_type{}, std::move(sys), std::move(x0), span, step, observer}
+    {}
+
+    template <class O = Observer, class = std::enable_if_t<std::is_same<O, null_observer>::value>>
     constexpr owning_step_iterator(system_type sys,
                                    state_type x0,
                                    iterator_step_type span,
                                    iterator_step_type step)
-        : system_{std::move(sys)}, state_{std::move(x0)}, span_{span}, step_{step}
+        : owning_step_iterator{stepper_type{}, std::move(sys), std::move(x0), span, step}
     {}
 
-    constexpr owning_step_iterator(system_type sys) : system_{std::move(sys)} {}
+    /// @brief End of a range, which holds no system and has no span left
+    /// @note Only needed before C++17, where a range-based for loop requires its end to have the
+    /// type of its begin. Compare with a `step_sentinel` otherwise.
+    owning_step_iterator() = default;
 
-    auto operator++() noexcept -> iterator&
+    auto operator++() -> iterator&
     {
         increment(stepper::stepper_tag<Stepper>{});
         return *this;
     }
 
-    auto operator++(int) noexcept -> iterator
+    auto operator++(int) -> iterator
     {
         auto self = *this;
         increment(stepper::stepper_tag<Stepper>{});
         return self;
     }
 
+    /// @brief Takes `n` steps, or the steps remaining if fewer, without visiting the states
+    /// between
+    /// @note With a fixed step and an integral `StepDuration` the steps are taken in a loop that
+    /// does not check for the end of the span.
+    auto advance(difference_type n) -> iterator&
+    {
+        advance(n, has_step_count{});
+        return *this;
+    }
+
+    /// @brief Number of states left to visit, computed from the span and step without stepping
+    /// @note Not available for controlled steppers, which choose their own step size, or for a
+    /// floating-point `StepDuration`, for which the number of steps depends on the rounding of
+    /// the accumulated elapsed time.
+    constexpr auto remaining() const noexcept -> difference_type
+    {
+        static_assert(has_step_count::value,
+                      "the number of steps is known only for a fixed step and an integral "
+                      "`StepDuration`");
+
+        if (!(elapsed_ < span_)) {
+            return 0;
+        }
+
+        const auto left = span_ - elapsed_;
+        const auto n = static_cast<difference_type>(left / step_);
+        return (step_ * n < left) ? (n + 1) : n;
+    }
+
+    /// @brief Number of states between `first` and `last` in constant time
+    /// @note Found by argument-dependent lookup, as an unqualified `distance` call with
+    /// `using std::distance;`
+    friend constexpr auto distance(const owning_step_iterator& first,
+                                   const owning_step_iterator& last) noexcept -> difference_type
+    {
+        return first.remaining() - last.remaining();
+    }
+
+    friend constexpr auto distance(const owning_step_iterator& first, step_sentinel) noexcept
+        -> difference_type
+    {
+        return first.remaining();
+    }
+
     constexpr auto operator==(const owning_step_iterator& other) const noexcept -> bool
     {
         if (other.at_end()) {
@@ -79,31 +349,160 @@ class owning_step_iterator {
         return !(*this == other);
     }
 
+    friend constexpr auto operator==(const owning_step_iterator& it, step_sentinel) noexcept
+        -> bool
+    {
+        return it.elapsed_ >= it.span_;
+    }
+
+    friend constexpr auto operator==(step_sentinel, const owning_step_iterator& it) noexcept
+        -> bool
+    {
+        return it.elapsed_ >= it.span_;
+    }
+
+    friend constexpr auto operator!=(const owning_step_iterator& it, step_sentinel) noexcept
+        -> bool
+    {
+        return it.elapsed_ < it.span_;
+    }
+
+    friend constexpr auto operator!=(step_sentinel, const owning_step_iterator& it) noexcept
+        -> bool
+    {
+        return it.elapsed_ < it.span_;
+    }
+
     constexpr auto operator*() -> reference
     {
         return std::make_pair(std::ref(elapsed_), std::ref(state_));
     }
 
   private:
+    using has_step_count = tmp::bool_constant<
+        !std::is_same<stepper::stepper_tag<Stepper>, stepper::odeint_controlled_tag>::value &&
+        !std::chrono::treat_as_floating_point<typename iterator_step_type::rep>::value>;
+
+    auto observer() const noexcept -> const observer_type& { return *this; }
+
+    auto advance(difference_type n, std::true_type) -> void
+    {
+        for (n = std::min(n, remaining()); n > 0; --n) {
+            increment(stepper::stepper_tag<Stepper>{});
+        }
+    }
+
+    auto advance(difference_type n, std::false_type) -> void
+    {
+        for (; (n > 0) && !at_end(); --n) {
+            increment(stepper::stepper_tag<Stepper>{});
+        }
+    }
+
+    template <class Tag>
+    constexpr auto start(Tag) noexcept -> void
+    {}
+
+    auto start(stepper::odeint_controlled_tag) -> void
+    {
+        using time_type = typename stepper_type::time_type;
+
+        adaptive_.t = time_type{};
+        adaptive_.dt = detail::to_stepper_time<time_type>(step_);
+    }
+
+    auto start(stepper::odeint_dense_output_tag) -> void
+    {
+        using time_type = typename stepper_type::time_type;
+
+        stepper_.initialize(state_, time_type{}, detail::to_stepper_time<time_type>(step_));
+    }
+
     auto increment(stepper::odeint_tag) -> void
     {
-        stepper_type{}.do_step(system_, state_, elapsed_, step_);
+        observer().on_step_begin(elapsed_, step_);
+        stepper_.do_step(detail::observe(system_.get(), observer()), state_, elapsed_, step_);
+        observer().on_step_end(elapsed_, step_);
         elapsed_ += step_;
     }
 
+    /// Takes a single accepted step, retrying each rejected step with the reduced step size
+    /// proposed by the stepper, with the final step shortened to end at `span`
+    auto increment(stepper::odeint_controlled_tag) -> void
+    {
+        using time_type = typename stepper_type::time_type;
+
+        const auto end = detail::to_stepper_time<time_type>(span_);
+        const auto t0 = adaptive_.t;
+
+        observer().on_step_begin(detail::to_seconds(t0), detail::to_seconds(adaptive_.dt));
+
+        for (;;) {
+            const auto last = !(adaptive_.dt < end - t0);
+            const auto attempted = last ? (end - t0) : adaptive_.dt;
+            auto dt = attempted;
+
+            const auto result = stepper_.try_step(
+                detail::observe(system_.get(), observer()), state_, adaptive_.t, dt);
+
+            // `odeint::success` is the first enumerator of `controlled_step_result`
+            if (result == decltype(result){}) {
+                observer().on_step_end(detail::to_seconds(t0), detail::to_seconds(attempted));
+
+                if (last) {
+                    elapsed_ = span_;
+                } else {
+                    adaptive_.dt = dt;
+                    elapsed_ = std::chrono::duration_cast<iterator_step_type>(
+                        detail::to_seconds(adaptive_.t));
+                }
+                return;
+            }
+
+            adaptive_.dt = dt;
+            observer().on_step_rejected(detail::to_seconds(t0), detail::to_seconds(dt));
+        }
+    }
+
+    /// Steps until the next sample lies within the last step and interpolates the state at it
+    auto increment(stepper::odeint_dense_output_tag) -> void
+    {
+        using time_type = typename stepper_type::time_type;
+
+        const auto next = elapsed_ + step_;
+        const auto t = detail::to_stepper_time<time_type>(next);
+
+        while (stepper_.current_time() < t) {
+            const auto t0 = stepper_.current_time();
+
+            observer().on_step_begin(detail::to_seconds(t0),
+                                     detail::to_seconds(stepper_.current_time_step()));
+            stepper_.do_step(detail::observe(system_.get(), observer()));
+            observer().on_step_end(detail::to_seconds(t0),
+                                   detail::to_seconds(stepper_.current_time() - t0));
+        }
+
+        stepper_.calc_state(t, state_);
+        elapsed_ = next;
+    }
+
     auto increment(stepper::state_space_tag) -> void
     {
-        state_ = stepper_type{}.step(system_, state_, elapsed_, step_);
+        observer().on_step_begin(elapsed_, step_);
+        state_ = stepper_.step(detail::observe(system_.get(), observer()), state_, elapsed_, step_);
+        observer().on_step_end(elapsed_, step_);
         elapsed_ += step_;
     }
 
     constexpr auto at_end() const noexcept -> bool { return elapsed_ >= span_; }
 
-    system_type system_;
+    stepper_type stepper_ = {};
+    detail::end_or_value<system_type> system_;
     state_type state_ = {};
     iterator_step_type span_ = {};
     iterator_step_type step_ = {};
     iterator_step_type elapsed_ = {};
+    detail::adaptive_step<Stepper, stepper::stepper_tag<Stepper>> adaptive_ = {};
 };
 
 template <class Stepper, class System, class State, class StepDuration>
@@ -111,12 +510,728 @@ constexpr auto make_owning_step_range(const System& sys,
                                       const State& x0,
                                       tmp::type_identity_t<StepDuration> span,
                                       StepDuration step)
+{
+    using iterator = owning_step_iterator<Stepper, System, State, StepDuration>;
+
+    return detail::sentinel_range<iterator>{iterator(sys, x0, span, step)};
+}
+
+/// Iterates over states at the end of each fixed step, reporting the integration to `observer`
+template <class Stepper, class System, class State, class StepDuration, class Observer>
+constexpr auto make_owning_step_range(const System& sys,
+                                      const State& x0,
+                                      tmp::type_identity_t<StepDuration> span,
+                                      StepDuration step,
+                                      Observer& observer)
+{
+    using iterator = owning_step_iterator<Stepper, System, State, StepDuration, Observer>;
+
+    return detail::sentinel_range<iterator>{iterator(sys, x0, span, step, observer)};
+}
+
+/// @brief Iterates over states at the end of each step of `stepper`, such as an odeint
+/// controlled stepper configured with tolerances
+template <class Stepper, class System, class State, class StepDuration>
+constexpr auto make_owning_step_range(const Stepper& stepper,
+                                      const System& sys,
+                                      const State& x0,
+                                      tmp::type_identity_t<StepDuration> span,
+                                      StepDuration step)
+{
+    using iterator = owning_step_iterator<Stepper, System, State, StepDuration>;
+
+    return detail::sentinel_range<iterator>{iterator(stepper, sys, x0, span, step)};
+}
+
+template <class Stepper, class System, class State, class StepDuration, class Observer>
+constexpr auto make_owning_step_range(const Stepper& stepper,
+                                      const System& sys,
+                                      const State& x0,
+                                      tmp::type_identity_t<StepDuration> span,
+                                      StepDuration step,
+                                      Observer& observer)
+{
+    using iterator = owning_step_iterator<Stepper, System, State, StepDuration, Observer>;
+
+    return detail::sentinel_range<iterator>{iterator(stepper, sys, x0, span, step, observer)};
+}
+
+namespace detail {
+
+template <class Iterator, class = void>
+struct has_advance : std::false_type {};
+
+template <class Iterator>
+struct has_advance<Iterator,
+                   tmp::void_t<decltype(std::declval<Iterator&>().advance(
+                       typename std::iterator_traits<Iterator>::difference_type{}))>>
+    : std::true_type {};
+
+}  // namespace detail
+
+/// @brief Visits every `k`-th state of a step range, starting with the first
+/// @tparam Sentinel type of the end of the wrapped range, an iterator or a `step_sentinel`
+/// @note Steps between visited states are taken with `Iterator::advance` when available, so the
+/// skipped states are never dereferenced.
+template <class Iterator, class Sentinel = Iterator>
+class strided_iterator {
+  public:
+    using iterator = strided_iterator;
+
+    using difference_type = typename std::iterator_traits<Iterator>::difference_type;
+    using value_type = typename std::iterator_traits<Iterator>::value_type;
+    using pointer = typename std::iterator_traits<Iterator>::pointer;
+    using reference = typename std::iterator_traits<Iterator>::reference;
+    using iterator_category = std::input_iterator_tag;
+
+    strided_iterator(Iterator it, Sentinel last, difference_type stride)
+        : it_{std::move(it)}, last_{std::move(last)}, stride_{stride}
+    {}
+
+    auto operator++() -> iterator&
+    {
+        advance(detail::has_advance<Iterator>{});
+        return *this;
+    }
+
+    auto operator++(int) -> iterator
+    {
+        auto self = *this;
+        ++*this;
+        return self;
+    }
+
+    auto operator==(const strided_iterator& other) const -> bool { return it_ == other.it_; }
+
+    auto operator!=(const strided_iterator& other) const -> bool { return !(*this == other); }
+
+    friend auto operator==(const strided_iterator& it, step_sentinel) -> bool
+    {
+        return it.it_ == it.last_;
+    }
+
+    friend auto operator!=(const strided_iterator& it, step_sentinel) -> bool
+    {
+        return it.it_ != it.last_;
+    }
+
+    auto operator*() -> reference { return *it_; }
+
+  private:
+    auto advance(std::true_type) -> void { it_.advance(stride_); }
+
+    auto advance(std::false_type) -> void
+    {
+        for (auto n = stride_; (n > 0) && (it_ != last_); --n) {
+            ++it_;
+        }
+    }
+
+    Iterator it_;
+    Sentinel last_;
+    difference_type stride_;
+};
+
+/// @brief Wraps a step range, such as one returned by `system::integrate_range`, to visit every
+/// `k`-th state
+template <class Range>
+auto stride(Range&& range,
+            typename std::iterator_traits<decltype(std::begin(range))>::difference_type k)
+{
+    using iterator = strided_iterator<decltype(std::begin(range)), decltype(std::end(range))>;
+    using difference_type = typename iterator::difference_type;
+
+    return detail::wrapped_range<iterator, Range, difference_type>{std::forward<Range>(range), k};
+}
+
+/// @brief Iterates over states sampled at a fixed interval independent of the integration step
+/// @note Each integration step produces an interpolant of the solution over the step from which
+/// all samples within the step are evaluated. Steps are only taken once a sample lies beyond the
+/// current interpolant.
+template <class Stepper, class System, class State, class StepDuration>
+class dense_output_iterator {
+    static_assert(tmp::is_specialization_of<StepDuration, std::chrono::duration>::value, "");
+    static_assert(stepper::is_dense_output_stepper<Stepper>::value,
+                  "`Stepper` must be a state space stepper providing dense output.");
+
+    using stepper_type = Stepper;
+    using system_type = System;
+    using state_type = State;
+    using iterator_step_type = StepDuration;
+    using dense_output_type = typename Stepper::dense_output_type;
+    using timepoint_type = typename Stepper::timepoint_type;
+
+  public:
+    using iterator = dense_output_iterator;
+
+    using difference_type = std::ptrdiff_t;
+    using value_type = std::pair<iterator_step_type, state_type>;
+    using pointer = std::add_pointer_t<value_type>;
+    using reference = std::pair<std::add_lvalue_reference_t<iterator_step_type>,
+                                std::add_lvalue_reference_t<state_type>>;
+    using iterator_category = std::input_iterator_tag;
+
+    constexpr dense_output_iterator(system_type sys,
+                                    state_type x0,
+                                    iterator_step_type span,
+                                    iterator_step_type step,
+                                    iterator_step_type sample)
+        : system_{std::move(sys)},
+          state_{std::move(x0)},
+          span_{span},
+          step_{step},
+          sample_{sample},
+          interpolant_{initial_interpolant(system_, state_)}
+    {}
+
+    constexpr dense_output_iterator(system_type sys) : system_{std::move(sys)} {}
+
+    auto operator++() -> iterator&
+    {
+        increment();
+        return *this;
+    }
+
+    auto operator++(int) -> iterator
+    {
+        auto self = *this;
+        increment();
+        return self;
+    }
+
+    constexpr auto operator==(const dense_output_iterator& other) const noexcept -> bool
+    {
+        if (other.at_end()) {
+            return at_end();
+        }
+
+        return (span_ == other.span_) && (step_ == other.step_) && (sample_ == other.sample_) &&
+               (elapsed_ == other.elapsed_);
+    }
+
+    constexpr auto operator!=(const dense_output_iterator& other) const noexcept -> bool
+    {
+        return !(*this == other);
+    }
+
+    constexpr auto operator*() -> reference
+    {
+        return std::make_pair(std::ref(elapsed_), std::ref(state_));
+    }
+
+    /// Interpolant of the integration step containing the current sample
+    constexpr auto interpolant() const noexcept -> const dense_output_type&
+    {
+        return interpolant_;
+    }
+
+  private:
+    static constexpr auto initial_interpolant(const system_type& sys, const state_type& x0)
+        -> dense_output_type
+    {
+        const auto dxdt = sys(timepoint_type{}, x0);
+
+        return {timepoint_type{}, timepoint_type{}, x0, x0, dxdt, dxdt};
+    }
+
+    auto increment() -> void
+    {
+        elapsed_ += sample_;
+
+        if (at_end()) {
+            return;
+        }
+
+        while (integrated_ < elapsed_) {
+            interpolant_ = stepper_type{}.dense_step(
+                system_, interpolant_.x1, interpolant_.dxdt1, integrated_, step_);
+            integrated_ += step_;
+        }
+
+        state_ = interpolant_(elapsed_);
+    }
+
+    constexpr auto at_end() const noexcept -> bool { return elapsed_ >= span_; }
+
+    system_type system_;
+    state_type state_ = {};
+    iterator_step_type span_ = {};
+    iterator_step_type step_ = {};
+    iterator_step_type sample_ = {};
+    iterator_step_type elapsed_ = {};
+    iterator_step_type integrated_ = {};
+    dense_output_type interpolant_ = {};
+};
+
+template <class Stepper, class System, class State, class StepDuration>
+constexpr auto make_dense_output_range(const System& sys,
+                                       const State& x0,
+                                       tmp::type_identity_t<StepDuration> span,
+                                       tmp::type_identity_t<StepDuration> step,
+                                       StepDuration sample)
 {
     return adapt_rangepair(std::make_pair(
-        owning_step_iterator<Stepper, System, State, StepDuration>(sys, x0, span, step),
-        owning_step_iterator<Stepper, System, State, StepDuration>(sys)));
+        dense_output_iterator<Stepper, System, State, StepDuration>(sys, x0, span, step, sample),
+        dense_output_iterator<Stepper, System, State, StepDuration>(sys)));
 }
 
+/// @brief Iterates over states integrated with inputs following a schedule
+/// @tparam Integrator provides `prepare(u)` and `step(x, u, p, t, dt)`, integrating a single
+/// step from `x` with input `u` and its preparation `p`. `prepare` is called each time the input
+/// changes, so an integrator may keep state between the steps taken with one input.
+/// @tparam Schedule provides the input held from the current time and the time of the next
+/// change, such as a `zero_order_hold` or `generated_input`
+/// @note Steps are taken on a grid of `step`. A step over which the input changes is split at
+/// the time of the change, visiting the state at that time, so that each step is integrated with
+/// a single input. An input is prepared once when it takes effect.
+template <class Integrator, class Schedule, class State, class StepDuration>
+class scheduled_step_iterator {
+    static_assert(tmp::is_specialization_of<StepDuration, std::chrono::duration>::value, "");
+
+    using integrator_type = Integrator;
+    using schedule_type = Schedule;
+    using state_type = State;
+    using iterator_step_type = StepDuration;
+    using input_type = typename Schedule::input_type;
+    using prepared_input_type = typename Integrator::prepared_input_type;
+
+  public:
+    using iterator = scheduled_step_iterator;
+
+    using difference_type = std::ptrdiff_t;
+    using value_type = std::pair<iterator_step_type, state_type>;
+    using pointer = std::add_pointer_t<value_type>;
+    using reference = std::pair<std::add_lvalue_reference_t<iterator_step_type>,
+                                std::add_lvalue_reference_t<state_type>>;
+    using iterator_category = std::input_iterator_tag;
+
+    scheduled_step_iterator(integrator_type integrator,
+                            schedule_type schedule,
+                            state_type x0,
+                            iterator_step_type span,
+                            iterator_step_type step)
+        : integrator_{std::move(integrator)},
+          schedule_{std::move(schedule)},
+          state_{std::move(x0)},
+          span_{span},
+          step_{step},
+          grid_{step}
+    {
+        schedule_.start(state_);
+        advance_schedule();
+        prepared_ = integrator_.prepare(schedule_.input());
+    }
+
+    scheduled_step_iterator(integrator_type integrator, schedule_type schedule)
+        : integrator_{std::move(integrator)}, schedule_{std::move(schedule)}
+    {}
+
+    auto operator++() -> iterator&
+    {
+        increment();
+        return *this;
+    }
+
+    auto operator++(int) -> iterator
+    {
+        auto self = *this;
+        increment();
+        return self;
+    }
+
+    auto operator==(const scheduled_step_iterator& other) const noexcept -> bool
+    {
+        if (other.at_end()) {
+            return at_end();
+        }
+
+        return (span_ == other.span_) && (step_ == other.step_) && (elapsed_ == other.elapsed_);
+    }
+
+    auto operator!=(const scheduled_step_iterator& other) const noexcept -> bool
+    {
+        return !(*this == other);
+    }
+
+    auto operator*() -> reference { return std::make_pair(std::ref(elapsed_), std::ref(state_)); }
+
+    /// Input held from the current state
+    auto input() const -> const input_type& { return schedule_.input(); }
+
+  private:
+    auto increment() -> void
+    {
+        const auto split = schedule_.has_next_change() && (schedule_.next_change() < grid_);
+        const auto target = split ? iterator_step_type{schedule_.next_change()} : grid_;
+
+        state_ =
+            integrator_.step(state_, schedule_.input(), prepared_, elapsed_, target - elapsed_);
+        elapsed_ = target;
+
+        if (!split) {
+            grid_ += step_;
+        }
+
+        if (advance_schedule()) {
+            prepared_ = integrator_.prepare(schedule_.input());
+        }
+    }
+
+    /// Advances the schedule past all changes up to the current time
+    auto advance_schedule() -> bool
+    {
+        auto changed = false;
+        while (schedule_.has_next_change() && !(elapsed_ < schedule_.next_change())) {
+            schedule_.advance(state_);
+            changed = true;
+        }
+        return changed;
+    }
+
+    auto at_end() const noexcept -> bool { return elapsed_ >= span_; }
+
+    integrator_type integrator_;
+    schedule_type schedule_;
+    state_type state_ = {};
+    iterator_step_type span_ = {};
+    iterator_step_type step_ = {};
+    iterator_step_type elapsed_ = {};
+    iterator_step_type grid_ = {};
+    prepared_input_type prepared_ = {};
+};
+
+template <class Integrator, class Schedule, class State, class StepDuration>
+auto make_scheduled_step_range(const Integrator& integrator,
+                               const Schedule& schedule,
+                               const State& x0,
+                               tmp::type_identity_t<StepDuration> span,
+                               StepDuration step)
+{
+    using iterator = scheduled_step_iterator<Integrator, Schedule, State, StepDuration>;
+
+    return adapt_rangepair(std::make_pair(iterator(integrator, schedule, x0, span, step),
+                                          iterator(integrator, schedule)));
+}
+
+/// @brief Iterates over states integrated on a grid of `step`, stopping at the zero crossings of
+/// event functions of the state
+/// @tparam Integrator provides `prepare(u)`, `step(x, u, p, t, dt)`, integrating a single step
+/// from `x` with input `u` and its preparation `p`, and `interpolate(x0, x1, p, t, dt)`,
+/// returning an interpolant of a step from `x0` to `x1`. `prepare` is called each time the input
+/// changes or the state is moved to an event.
+/// @tparam Events tuple of `event`
+/// @note Event functions are evaluated at the end of each step. Only if one crosses zero is the
+/// step interpolated and the crossing located on the interpolant, so locating an event requires
+/// no additional steps. The state at the earliest crossing is visited and integration continues
+/// from it on the grid of `step`, unless the action of the event ends integration. Event times
+/// are rounded up to a multiple of the period of `StepDuration`; a floating point duration
+/// locates events to within their tolerance.
+template <class Integrator, class Events, class State, class StepDuration>
+class event_step_iterator {
+    static_assert(tmp::is_specialization_of<StepDuration, std::chrono::duration>::value, "");
+
+    using integrator_type = Integrator;
+    using events_type = Events;
+    using state_type = State;
+    using iterator_step_type = StepDuration;
+    using input_type = typename Integrator::input_type;
+    using prepared_input_type = typename Integrator::prepared_input_type;
+    using interpolant_type = typename Integrator::interpolant_type;
+
+    static constexpr auto event_count = std::tuple_size<Events>::value;
+
+    using event_values = std::array<double, event_count>;
+
+    /// Earliest crossing within a step, as the index of the event and the fraction of the step
+    struct crossing {
+        std::size_t index;
+        double fraction;
+    };
+
+  public:
+    using iterator = event_step_iterator;
+
+    using difference_type = std::ptrdiff_t;
+    using value_type = std::pair<iterator_step_type, state_type>;
+    using pointer = std::add_pointer_t<value_type>;
+    using reference = std::pair<std::add_lvalue_reference_t<iterator_step_type>,
+                                std::add_lvalue_reference_t<state_type>>;
+    using iterator_category = std::input_iterator_tag;
+
+    event_step_iterator(integrator_type integrator,
+                        events_type events,
+                        state_type x0,
+                        input_type u,
+                        iterator_step_type span,
+                        iterator_step_type step)
+        : integrator_{std::move(integrator)},
+          events_{std::move(events)},
+          state_{std::move(x0)},
+          input_{std::move(u)},
+          span_{span},
+          step_{step},
+          grid_{step}
+    {
+        restart();
+    }
+
+    event_step_iterator(integrator_type integrator, events_type events)
+        : integrator_{std::move(integrator)}, events_{std::move(events)}
+    {}
+
+    auto operator++() -> iterator&
+    {
+        increment();
+        return *this;
+    }
+
+    auto operator++(int) -> iterator
+    {
+        auto self = *this;
+        increment();
+        return self;
+    }
+
+    auto operator==(const event_step_iterator& other) const noexcept -> bool
+    {
+        if (other.at_end()) {
+            return at_end();
+        }
+
+        return (span_ == other.span_) && (step_ == other.step_) &&
+               (elapsed_ == other.elapsed_) && (terminated_ == other.terminated_);
+    }
+
+    auto operator!=(const event_step_iterator& other) const noexcept -> bool
+    {
+        return !(*this == other);
+    }
+
+    auto operator*() -> reference { return std::make_pair(std::ref(elapsed_), std::ref(state_)); }
+
+    /// Input held from the current state
+    auto input() const noexcept -> const input_type& { return input_; }
+
+    /// True if the current state is that of an event ending integration
+    auto terminating() const noexcept -> bool { return terminating_; }
+
+  private:
+    /// Prepares the input and evaluates the event functions at the current state
+    auto restart() -> void
+    {
+        prepared_ = integrator_.prepare(input_);
+        values_ = evaluate_events(state_, std::make_index_sequence<event_count>{});
+    }
+
+    auto increment() -> void
+    {
+        if (terminating_) {
+            terminated_ = true;
+            return;
+        }
+
+        const auto target = grid_;
+        const auto dt = target - elapsed_;
+
+        const auto x1 = integrator_.step(state_, input_, prepared_, elapsed_, dt);
+        const auto values = evaluate_events(x1, std::make_index_sequence<event_count>{});
+
+        if (!crossed(values, std::make_index_sequence<event_count>{})) {
+            state_ = x1;
+            values_ = values;
+            elapsed_ = target;
+            grid_ += step_;
+            return;
+        }
+
+        const auto interpolant = integrator_.interpolate(state_, x1, prepared_, elapsed_, dt);
+        const auto earliest =
+            locate_events(interpolant, values, dt, std::make_index_sequence<event_count>{});
+        const auto t = event_time(dt, earliest.fraction);
+
+        if (t == target) {
+            state_ = x1;
+        } else {
+            const auto fraction = std::chrono::duration<double>{t - elapsed_} /
+                                  std::chrono::duration<double>{dt};
+            state_ = interpolant(interpolant.t0 + interpolant.dt * fraction);
+        }
+
+        elapsed_ = t;
+
+        if (elapsed_ == grid_) {
+            grid_ += step_;
+        }
+
+        terminating_ = (act(earliest.index, std::make_index_sequence<event_count>{}) ==
+                        event_action::terminate);
+        restart();
+    }
+
+    template <std::size_t... Is>
+    auto crossed(const event_values& values, std::index_sequence<Is...>) const -> bool
+    {
+        auto any = false;
+
+        const auto unused = {
+            (any = any || detail::event_crossed(std::get<Is>(events_).direction, values_[Is],
+                                                values[Is]),
+             0)...};
+        (void)unused;
+
+        return any;
+    }
+
+    /// Time of a crossing at `fraction` of a step of `dt`, rounded up to the period of
+    /// `StepDuration`
+    auto event_time(iterator_step_type dt, double fraction) const -> iterator_step_type
+    {
+        const auto offset =
+            std::chrono::duration<double, typename iterator_step_type::period>{fraction *
+                                                                               dt.count()};
+
+        auto rounded = std::chrono::duration_cast<iterator_step_type>(offset);
+        if (rounded < offset) {
+            rounded += iterator_step_type{1};
+        }
+
+        return elapsed_ + std::min(rounded, dt);
+    }
+
+    template <std::size_t... Is>
+    auto locate_events(const interpolant_type& interpolant,
+                       const event_values& values,
+                       iterator_step_type dt,
+                       std::index_sequence<Is...>) const -> crossing
+    {
+        auto earliest = crossing{event_count, 1.0};
+
+        const auto unused = {(locate<Is>(interpolant, values[Is], dt, earliest), 0)...};
+        (void)unused;
+
+        return earliest;
+    }
+
+    template <std::size_t I>
+    auto locate(const interpolant_type& interpolant,
+                double value,
+                iterator_step_type dt,
+                crossing& earliest) const -> void
+    {
+        const auto& e = std::get<I>(events_);
+
+        if (!detail::event_crossed(e.direction, values_[I], value)) {
+            return;
+        }
+
+        const auto fraction = detail::locate_crossing(
+            [&e, &interpolant](double s) {
+                return detail::event_value(
+                    e.function(interpolant(interpolant.t0 + interpolant.dt * s)));
+            },
+            values_[I],
+            value,
+            e.tolerance / std::chrono::duration<double>{dt});
+
+        if ((earliest.index == event_count) || (fraction < earliest.fraction)) {
+            earliest = crossing{I, fraction};
+        }
+    }
+
+    template <std::size_t... Is>
+    auto act(std::size_t index, std::index_sequence<Is...>) -> event_action
+    {
+        auto action = event_action::resume;
+
+        const auto unused = {
+            ((Is == index) ? (action = std::get<Is>(events_).action(elapsed_, state_, input_), 0)
+                           : 0)...};
+        (void)unused;
+
+        return action;
+    }
+
+    template <std::size_t... Is>
+    auto evaluate_events(const state_type& x, std::index_sequence<Is...>) const -> event_values
+    {
+        return {{detail::event_value(std::get<Is>(events_).function(x))...}};
+    }
+
+    auto at_end() const noexcept -> bool { return terminated_ || (elapsed_ >= span_); }
+
+    integrator_type integrator_;
+    events_type events_;
+    state_type state_ = {};
+    input_type input_ = {};
+    prepared_input_type prepared_ = {};
+    event_values values_ = {};
+    iterator_step_type span_ = {};
+    iterator_step_type step_ = {};
+    iterator_step_type elapsed_ = {};
+    iterator_step_type grid_ = {};
+    bool terminating_ = false;
+    bool terminated_ = false;
+};
+
+template <class Integrator, class Events, class State, class StepDuration>
+auto make_event_step_range(const Integrator& integrator,
+                           const Events& events,
+                           const State& x0,
+                           const typename Integrator::input_type& u,
+                           tmp::type_identity_t<StepDuration> span,
+                           StepDuration step)
+{
+    using iterator = event_step_iterator<Integrator, Events, State, StepDuration>;
+
+    return adapt_rangepair(std::make_pair(iterator(integrator, events, x0, u, span, step),
+                                          iterator(integrator, events)));
+}
+
+namespace detail {
+
+/// Prepares inputs with `Model::prepare` if provided and otherwise holds them unchanged
+template <class Model, class = void>
+struct model_prepare {
+    using type = typename Model::input;
+
+    static auto prepare(const typename Model::input& u) -> type { return u; }
+};
+
+template <class Model>
+struct model_prepare<Model,
+                     tmp::void_t<decltype(Model::prepare(std::declval<typename Model::input>()))>> {
+    using type = decltype(Model::prepare(std::declval<typename Model::input>()));
+
+    static auto prepare(const typename Model::input& u) -> type { return Model::prepare(u); }
+};
+
+/// Steps a model with a stepper shared by consecutive steps and replaced when an input is prepared
+template <class Model, class Stepper>
+struct model_integrator {
+    using prepared_input_type = typename model_prepare<Model>::type;
+
+    auto prepare(const typename Model::input& u) -> prepared_input_type
+    {
+        instance = Stepper{};
+        return model_prepare<Model>::prepare(u);
+    }
+
+    template <class StepDuration>
+    auto step(typename Model::state x,
+              const typename Model::input&,
+              const prepared_input_type& p,
+              StepDuration t,
+              StepDuration dt) -> typename Model::state
+    {
+        instance.do_step(Model::state_transition(p), x, t, dt);
+        return x;
+    }
+
+    Stepper instance = {};
+};
+
+}  // namespace detail
+
 template <class Model,
           template <class...>
           class Stepper,
@@ -133,4 +1248,41 @@ auto make_owning_step_range(const typename Model::state& x0,
         Model::state_transition(u), x0, span, step);
 }
 
+/// @brief Iterates over states of `Model` at the end of each step of `stepper`
+/// @tparam Stepper specialized with `Model::specialize_stepper`, such as an odeint controlled
+/// stepper configured with tolerances
+template <class Model,
+          class Stepper,
+          class StepDuration,
+          class = std::enable_if_t<std::is_void<tmp::void_t<decltype(
+              Model::state_transition(std::declval<typename Model::input>()))>>::value>>
+auto make_owning_step_range(const Stepper& stepper,
+                            const typename Model::state& x0,
+                            const typename Model::input& u,
+                            tmp::type_identity_t<StepDuration> span,
+                            StepDuration step)
+{
+    return make_owning_step_range(stepper, Model::state_transition(u), x0, span, step);
+}
+
+template <class Model,
+          template <class...>
+          class Stepper,
+          class Schedule,
+          class StepDuration,
+          class = std::enable_if_t<std::is_void<
+              tmp::void_t<typename Model::template specialize_stepper<Stepper>>>::value>>
+auto make_scheduled_step_range(const Schedule& schedule,
+                               const typename Model::state& x0,
+                               tmp::type_identity_t<StepDuration> span,
+                               StepDuration step)
+{
+    return make_scheduled_step_range(
+        detail::model_integrator<Model, typename Model::template specialize_stepper<Stepper>>{},
+        schedule,
+        x0,
+        span,
+        step);
+}
+
 }  // namespace ode
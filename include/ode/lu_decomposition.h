@@ -0,0 +1,99 @@
+#pragma once
+
+#include <cstddef>
+
+namespace ode {
+
+/// @brief LU decomposition with partial pivoting of a dense `N` by `N` matrix
+/// @note Storage is fixed at compile time so neither decomposition nor solution allocates.
+/// Matrices and vectors are built-in arrays, which unlike `std::array` may be modified within
+/// constant expressions.
+template <class Real, std::size_t N>
+class lu_decomposition {
+  public:
+    static_assert(N > 0, "A decomposition requires a matrix with more than zero rows.");
+
+    using matrix_type = Real[N][N];
+    using vector_type = Real[N];
+
+    constexpr explicit lu_decomposition(const matrix_type& a)
+    {
+        for (auto i = std::size_t{}; i < N; ++i) {
+            for (auto j = std::size_t{}; j < N; ++j) {
+                lu_[i][j] = a[i][j];
+            }
+        }
+
+        factorize();
+    }
+
+    /// True if a zero or NaN pivot was encountered, in which case `solve` is undefined
+    constexpr auto singular() const noexcept -> bool { return singular_; }
+
+    /// Solve A x = b, overwriting `b` with `x`
+    constexpr auto solve(vector_type& b) const noexcept -> void
+    {
+        for (auto k = std::size_t{}; k < N; ++k) {
+            const auto p = pivot_[k];
+            const auto bk = b[k];
+            b[k] = b[p];
+            b[p] = bk;
+        }
+
+        for (auto i = std::size_t{1}; i < N; ++i) {
+            for (auto j = std::size_t{}; j < i; ++j) {
+                b[i] -= lu_[i][j] * b[j];
+            }
+        }
+
+        for (auto i = N; i-- > 0;) {
+            for (auto j = i + 1; j < N; ++j) {
+                b[i] -= lu_[i][j] * b[j];
+            }
+            b[i] /= lu_[i][i];
+        }
+    }
+
+  private:
+    static constexpr auto abs(Real x) noexcept -> Real { return (x < Real{0}) ? -x : x; }
+
+    constexpr auto factorize() noexcept -> void
+    {
+        for (auto k = std::size_t{}; k < N; ++k) {
+            auto p = k;
+            for (auto i = k + 1; i < N; ++i) {
+                if (abs(lu_[p][k]) < abs(lu_[i][k])) {
+                    p = i;
+                }
+            }
+
+            pivot_[k] = p;
+
+            // also true for a NaN pivot
+            if (!(abs(lu_[p][k]) > Real{0})) {
+                singular_ = true;
+                continue;
+            }
+
+            for (auto j = std::size_t{}; j < N; ++j) {
+                const auto kj = lu_[k][j];
+                lu_[k][j] = lu_[p][j];
+                lu_[p][j] = kj;
+            }
+
+            for (auto i = k + 1; i < N; ++i) {
+                lu_[i][k] /= lu_[k][k];
+
+                for (auto j = k + 1; j < N; ++j) {
+                    lu_[i][j] -= lu_[i][k] * lu_[k][j];
+                }
+            }
+        }
+    }
+
+    Real lu_[N][N] = {};
+    std::size_t pivot_[N] = {};
+    bool singular_ = false;
+};
+
+}  // namespace ode
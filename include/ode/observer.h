@@ -0,0 +1,265 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <ostream>
+#include <utility>
+#include <vector>
+
+namespace ode {
+
+/// @brief Observer that ignores every event, selected by default
+/// @note Iterating with the null observer compiles to the same code as iterating without an
+/// observer. An observer provides the hooks below, each called with the elapsed time at the start
+/// of a step and the step size.
+struct null_observer {
+    /// Called before each evaluation of the right-hand side
+    constexpr auto on_rhs_evaluation() const noexcept -> void {}
+
+    template <class Duration>
+    constexpr auto on_step_begin(Duration, Duration) const noexcept -> void
+    {}
+
+    template <class Duration>
+    constexpr auto on_step_end(Duration, Duration) const noexcept -> void
+    {}
+
+    /// Called when a controlled stepper rejects a step, before it is retried with `step`
+    template <class Duration>
+    constexpr auto on_step_rejected(Duration, Duration) const noexcept -> void
+    {}
+};
+
+/// @brief Counts right-hand side evaluations and steps and measures the wall time of each step
+class counting_observer {
+    using clock = std::chrono::steady_clock;
+
+  public:
+    auto on_rhs_evaluation() noexcept -> void { ++rhs_evaluations_; }
+
+    template <class Duration>
+    auto on_step_begin(Duration, Duration) noexcept -> void
+    {
+        start_ = clock::now();
+    }
+
+    template <class Duration>
+    auto on_step_end(Duration, Duration) noexcept -> void
+    {
+        const auto t = clock::now() - start_;
+
+        ++steps_;
+        step_time_ += t;
+        max_step_time_ = std::max(max_step_time_, t);
+    }
+
+    template <class Duration>
+    auto on_step_rejected(Duration, Duration) noexcept -> void
+    {
+        ++rejected_steps_;
+    }
+
+    auto rhs_evaluations() const noexcept -> std::size_t { return rhs_evaluations_; }
+
+    /// Number of accepted steps
+    auto steps() const noexcept -> std::size_t { return steps_; }
+
+    auto rejected_steps() const noexcept -> std::size_t { return rejected_steps_; }
+
+    /// Total wall time of all steps, including rejected attempts
+    auto step_time() const noexcept -> clock::duration { return step_time_; }
+
+    auto max_step_time() const noexcept -> clock::duration { return max_step_time_; }
+
+    auto mean_step_time() const noexcept -> std::chrono::duration<double, std::nano>
+    {
+        return (steps_ > 0) ? (std::chrono::duration<double, std::nano>{step_time_} /
+                               static_cast<double>(steps_))
+                            : std::chrono::duration<double, std::nano>{};
+    }
+
+  private:
+    std::size_t rhs_evaluations_ = 0;
+    std::size_t steps_ = 0;
+    std::size_t rejected_steps_ = 0;
+    clock::duration step_time_ = {};
+    clock::duration max_step_time_ = {};
+    clock::time_point start_ = {};
+};
+
+/// @brief Records a timeline of steps, written in the Chrome trace event format
+/// @note The trace is viewed with `chrome://tracing` or Perfetto. Each step is a complete event
+/// with the elapsed integration time, step size and number of right-hand side evaluations as
+/// arguments. Each rejected step is an instant event.
+class trace_observer {
+    using clock = std::chrono::steady_clock;
+
+    enum class event_kind { step, rejected };
+
+    struct event {
+        event_kind kind;
+        clock::time_point start;
+        clock::duration duration;
+        double elapsed;
+        double step;
+        std::size_t rhs_evaluations;
+    };
+
+  public:
+    explicit trace_observer(std::size_t reserve = 0) { events_.reserve(reserve); }
+
+    auto on_rhs_evaluation() noexcept -> void { ++rhs_evaluations_; }
+
+    template <class Duration>
+    auto on_step_begin(Duration, Duration) noexcept -> void
+    {
+        rhs_evaluations_ = 0;
+        start_ = clock::now();
+    }
+
+    template <class Duration>
+    auto on_step_end(Duration elapsed, Duration step) -> void
+    {
+        const auto now = clock::now();
+        events_.push_back({event_kind::step,
+                           start_,
+                           now - start_,
+                           seconds(elapsed),
+                           seconds(step),
+                           rhs_evaluations_});
+    }
+
+    template <class Duration>
+    auto on_step_rejected(Duration elapsed, Duration step) -> void
+    {
+        events_.push_back({event_kind::rejected,
+                           clock::now(),
+                           {},
+                           seconds(elapsed),
+                           seconds(step),
+                           rhs_evaluations_});
+    }
+
+    /// Number of events recorded
+    auto size() const noexcept -> std::size_t { return events_.size(); }
+
+    auto clear() noexcept -> void { events_.clear(); }
+
+    /// Writes the recorded events as a JSON object with times relative to the first event
+    auto write_chrome_trace(std::ostream& os) const -> void
+    {
+        const auto origin = events_.empty() ? clock::time_point{} : events_.front().start;
+        const auto micros = [](clock::duration d) {
+            return std::chrono::duration<double, std::micro>{d}.count();
+        };
+
+        os << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[";
+
+        auto separator = "";
+        for (const auto& e : events_) {
+            os << separator << "{\"name\":\""
+               << ((e.kind == event_kind::step) ? "step\",\"ph\":\"X\"" : "rejected\",\"ph\":\"i\"")
+               << ",\"pid\":1,\"tid\":1,\"ts\":" << micros(e.start - origin);
+            if (e.kind == event_kind::step) {
+                os << ",\"dur\":" << micros(e.duration);
+            } else {
+                os << ",\"s\":\"t\"";
+            }
+            os << ",\"args\":{\"elapsed\":" << e.elapsed << ",\"step\":" << e.step
+               << ",\"rhs_evaluations\":" << e.rhs_evaluations << "}}";
+            separator = ",";
+        }
+
+        os << "]}\n";
+    }
+
+  private:
+    template <class Duration>
+    static auto seconds(Duration d) -> double
+    {
+        return std::chrono::duration<double>{d}.count();
+    }
+
+    std::vector<event> events_;
+    std::size_t rhs_evaluations_ = 0;
+    clock::time_point start_ = {};
+};
+
+namespace detail {
+
+/// Refers to an observer held outside an iterator
+template <class Observer>
+class observer_handle {
+  public:
+    constexpr observer_handle() = default;
+    constexpr observer_handle(Observer& observer) noexcept : observer_{&observer} {}
+
+    constexpr auto on_rhs_evaluation() const -> void { observer_->on_rhs_evaluation(); }
+
+    template <class Duration>
+    constexpr auto on_step_begin(Duration elapsed, Duration step) const -> void
+    {
+        observer_->on_step_begin(elapsed, step);
+    }
+
+    template <class Duration>
+    constexpr auto on_step_end(Duration elapsed, Duration step) const -> void
+    {
+        observer_->on_step_end(elapsed, step);
+    }
+
+    template <class Duration>
+    constexpr auto on_step_rejected(Duration elapsed, Duration step) const -> void
+    {
+        observer_->on_step_rejected(elapsed, step);
+    }
+
+  private:
+    Observer* observer_ = nullptr;
+};
+
+template <>
+class observer_handle<null_observer> : public null_observer {
+  public:
+    constexpr observer_handle() = default;
+    constexpr observer_handle(null_observer&) noexcept {}
+};
+
+/// Counts each evaluation of a system, forwarding its call operator and Jacobian
+template <class System, class Observer>
+struct observed_system {
+    template <class... Args>
+    constexpr auto operator()(Args&&... args) const -> decltype(auto)
+    {
+        observer.on_rhs_evaluation();
+        return system(std::forward<Args>(args)...);
+    }
+
+    template <class... Args, class S = System>
+    constexpr auto jacobian(Args&&... args) const
+        -> decltype(std::declval<const S&>().jacobian(std::forward<Args>(args)...))
+    {
+        return system.jacobian(std::forward<Args>(args)...);
+    }
+
+    const System& system;
+    observer_handle<Observer> observer;
+};
+
+template <class System>
+constexpr auto observe(const System& system, observer_handle<null_observer>) noexcept
+    -> const System&
+{
+    return system;
+}
+
+template <class System, class Observer>
+constexpr auto observe(const System& system, observer_handle<Observer> observer) noexcept
+    -> observed_system<System, Observer>
+{
+    return {system, observer};
+}
+
+}  // namespace detail
+}  // namespace ode
@@ -144,15 +144,26 @@ struct model {
         return units::math::atan(lr / (lf + lr) * units::math::tan(deltaf));
     }
 
-    static auto state_transition(input u)
-    {
-        return [u](const state& x, deriv& dxdt, duration_type /* t */) {
-            const auto beta = course(u.deltaf);
+    /// Input together with invariants of the state transition that depend only on the input
+    struct prepared_input {
+        input u;
+
+        /// Vehicle course, relative to yaw
+        angle_type beta;
+    };
 
-            dxdt.x = x.v * units::math::cos(x.yaw + beta);
-            dxdt.y = x.v * units::math::sin(x.yaw + beta);
-            dxdt.yaw = x.v / lr * units::math::sin(beta) * angle_type{1};
-            dxdt.v = u.a;
+    static auto prepare(input u) -> prepared_input { return {u, course(u.deltaf)}; }
+
+    static auto state_transition(input u) { return state_transition(prepare(u)); }
+
+    /// State transition reusing the invariants of a prepared input in each evaluation
+    static auto state_transition(prepared_input p)
+    {
+        return [p](const state& x, deriv& dxdt, duration_type /* t */) {
+            dxdt.x = x.v * units::math::cos(x.yaw + p.beta);
+            dxdt.y = x.v * units::math::sin(x.yaw + p.beta);
+            dxdt.yaw = x.v / lr * units::math::sin(p.beta) * angle_type{1};
+            dxdt.v = p.u.a;
         };
     }
 };
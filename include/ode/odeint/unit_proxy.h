@@ -1,5 +1,6 @@
 #pragma once
 
+#include "ode/tmp/type_traits.h"
 #include "units.h"
 
 namespace ode {
@@ -0,0 +1,198 @@
+#pragma once
+
+#include "boost/numeric/odeint.hpp"
+#include "ode/odeint/wire_format.h"
+#include "ode/state_space/wire_format.h"
+#include "ode/tmp/type_traits.h"
+#include "units.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+// Allows odeint controlled and dense output steppers with `vector_space_algebra` to measure the
+// error of states with units, either a `state_space::vector` or a state of an `odeint::model`.
+//
+// odeint measures the error of a step by removing the unit of each value with `get_unit_value`
+// and taking the largest relative error with `vector_space_norm_inf`. With `vector_space_algebra`
+// these are applied to a whole state, so a state is converted to the underlying values of its
+// elements, described by `state_space::wire_traits`.
+
+namespace ode {
+namespace odeint {
+namespace detail {
+
+/// Underlying values of the elements of a state, without units
+template <class Real, std::size_t N>
+struct raw_values {
+    template <class F>
+    friend auto transform(const raw_values& a, const raw_values& b, F f) -> raw_values
+    {
+        auto c = raw_values{};
+        for (auto i = std::size_t{}; i < N; ++i) {
+            c.values[i] = f(a.values[i], b.values[i]);
+        }
+        return c;
+    }
+
+    friend auto abs(raw_values a) -> raw_values
+    {
+        for (auto& v : a.values) {
+            v = std::abs(v);
+        }
+        return a;
+    }
+
+    friend auto operator+(const raw_values& a, const raw_values& b) -> raw_values
+    {
+        return transform(a, b, [](Real x, Real y) { return x + y; });
+    }
+
+    friend auto operator/(const raw_values& a, const raw_values& b) -> raw_values
+    {
+        return transform(a, b, [](Real x, Real y) { return x / y; });
+    }
+
+    template <class Scalar, class = std::enable_if_t<std::is_constructible<Real, Scalar>::value>>
+    friend auto operator+(const Scalar& s, raw_values a) -> raw_values
+    {
+        for (auto& v : a.values) {
+            v += static_cast<Real>(s);
+        }
+        return a;
+    }
+
+    template <class Scalar, class = std::enable_if_t<std::is_constructible<Real, Scalar>::value>>
+    friend auto operator*(const Scalar& s, raw_values a) -> raw_values
+    {
+        for (auto& v : a.values) {
+            v *= static_cast<Real>(s);
+        }
+        return a;
+    }
+
+    std::array<Real, N> values;
+};
+
+template <class State, class = void>
+struct has_values : std::false_type {};
+
+template <class State>
+struct has_values<State, tmp::void_t<typename state_space::wire_traits<State>::value_types>>
+    : std::true_type {};
+
+template <class ValueTypes>
+struct underlying_values;
+
+template <class... Values>
+struct underlying_values<tmp::list<Values...>> {
+    using real_type = std::common_type_t<typename Values::underlying_type...>;
+
+    static constexpr std::size_t size = sizeof...(Values);
+};
+
+template <class State>
+struct state_values {
+    using traits = state_space::wire_traits<State>;
+    using value_types = typename traits::value_types;
+    using real_type = typename underlying_values<value_types>::real_type;
+    using raw_type = raw_values<real_type, underlying_values<value_types>::size>;
+    using indices = std::make_index_sequence<underlying_values<value_types>::size>;
+
+    template <std::size_t... Is>
+    static auto get(const State& x, std::index_sequence<Is...>) -> raw_type
+    {
+        return {{{static_cast<real_type>(traits::template get<Is>(x).value())...}}};
+    }
+
+    static auto get(const State& x) -> raw_type
+    {
+        return get(x, indices{});
+    }
+
+    template <std::size_t... Is>
+    static auto set(State& x, const raw_type& r, std::index_sequence<Is...>) -> void
+    {
+        const auto unused = {(traits::template get<Is>(x) = tmp::at<Is, value_types>{
+                                  static_cast<typename tmp::at<Is, value_types>::underlying_type>(
+                                      r.values[Is])},
+                              0)...};
+        (void)unused;
+    }
+
+    static auto set(State& x, const raw_type& r) -> void
+    {
+        set(x, r, indices{});
+    }
+};
+
+}  // namespace detail
+}  // namespace odeint
+}  // namespace ode
+
+namespace boost {
+namespace numeric {
+namespace odeint {
+
+template <class State>
+struct vector_space_norm_inf<State,
+                             std::enable_if_t<ode::odeint::detail::has_values<State>::value>> {
+    using result_type = typename ode::odeint::detail::state_values<State>::real_type;
+
+    auto operator()(const State& x) const -> result_type
+    {
+        const auto r = ode::odeint::detail::state_values<State>::get(x);
+
+        auto norm = result_type{};
+        for (const auto v : r.values) {
+            norm = std::max(norm, static_cast<result_type>(std::abs(v)));
+        }
+        return norm;
+    }
+};
+
+namespace detail {
+
+template <class Unit>
+struct get_unit_value_impl<Unit, std::enable_if_t<::units::traits::is_unit_t<Unit>::value>> {
+    using result_type = typename Unit::underlying_type;
+
+    static auto value(const Unit& t) -> result_type { return t.value(); }
+};
+
+template <class Unit, class V>
+struct set_unit_value_impl<Unit, V, std::enable_if_t<::units::traits::is_unit_t<Unit>::value>> {
+    static auto set_value(Unit& t, const V& v) -> void
+    {
+        t = Unit{static_cast<typename Unit::underlying_type>(v)};
+    }
+};
+
+template <class State>
+struct get_unit_value_impl<State,
+                           std::enable_if_t<ode::odeint::detail::has_values<State>::value>> {
+    using result_type = typename ode::odeint::detail::state_values<State>::raw_type;
+
+    static auto value(const State& x) -> result_type
+    {
+        return ode::odeint::detail::state_values<State>::get(x);
+    }
+};
+
+template <class State, class V>
+struct set_unit_value_impl<State,
+                           V,
+                           std::enable_if_t<ode::odeint::detail::has_values<State>::value>> {
+    static auto set_value(State& x, const V& v) -> void
+    {
+        ode::odeint::detail::state_values<State>::set(x, v);
+    }
+};
+
+}  // namespace detail
+}  // namespace odeint
+}  // namespace numeric
+}  // namespace boost
@@ -0,0 +1,52 @@
+#pragma once
+
+#include "ode/odeint/model.h"
+#include "ode/state_space/wire_format.h"
+#include "ode/tmp/type_traits.h"
+
+#include <array>
+#include <tuple>
+#include <type_traits>
+
+namespace ode {
+namespace state_space {
+
+/// Values of a state of an `odeint::model`, in the order of its members
+template <class State>
+struct wire_traits<State,
+                   std::enable_if_t<tmp::is_specialization_of<typename State::model_type,
+                                                              odeint::model>::value &&
+                                    (State::deriv_order >= 0)>> {
+    using value_types = tmp::list<typename State::x_type,
+                                  typename State::y_type,
+                                  typename State::yaw_type,
+                                  typename State::v_type>;
+
+    static constexpr bool is_contiguous =
+        std::is_standard_layout<State>::value &&
+        (sizeof(State) == 4 * sizeof(typename State::real_type));
+
+    static constexpr auto key_names() -> std::array<const char*, 4>
+    {
+        return {{"x", "y", "yaw", "v"}};
+    }
+
+    template <std::size_t I>
+    static auto get(const State& s) -> decltype(auto)
+    {
+        return std::get<I>(std::tie(s.x, s.y, s.yaw, s.v));
+    }
+
+    template <std::size_t I>
+    static auto get(State& s) -> decltype(auto)
+    {
+        return std::get<I>(std::tie(s.x, s.y, s.yaw, s.v));
+    }
+
+    static auto data(const State& s) -> const void* { return &s; }
+
+    static auto data(State& s) -> void* { return &s; }
+};
+
+}  // namespace state_space
+}  // namespace ode
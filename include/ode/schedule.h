@@ -0,0 +1,120 @@
+#pragma once
+
+#include "ode/tmp/type_traits.h"
+
+#include <cassert>
+#include <chrono>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+
+namespace ode {
+
+/// @brief Holds each of a sequence of inputs from its time until the time of the next
+/// @tparam Iterator iterator over pairs of a `std::chrono::duration` and an input, ordered by
+/// time
+/// @note The first input is held from the start of integration, whatever its time. The sequence
+/// is not copied and must outlive the schedule.
+template <class Iterator>
+class zero_order_hold {
+    using element_type = typename std::iterator_traits<Iterator>::value_type;
+
+  public:
+    using duration_type = std::decay_t<decltype(std::declval<element_type>().first)>;
+    using input_type = std::decay_t<decltype(std::declval<element_type>().second)>;
+
+    static_assert(tmp::is_specialization_of<duration_type, std::chrono::duration>::value,
+                  "The time of each input must be a `std::chrono::duration`.");
+
+    constexpr zero_order_hold(Iterator first, Iterator last) : current_{first}, last_{last}
+    {
+        assert(first != last);
+    }
+
+    template <class State>
+    constexpr auto start(const State&) noexcept -> void
+    {}
+
+    constexpr auto input() const -> const input_type& { return current_->second; }
+
+    constexpr auto has_next_change() const -> bool { return std::next(current_) != last_; }
+
+    constexpr auto next_change() const -> duration_type { return std::next(current_)->first; }
+
+    template <class State>
+    constexpr auto advance(const State&) -> void
+    {
+        ++current_;
+    }
+
+  private:
+    Iterator current_;
+    Iterator last_;
+};
+
+template <class Iterator>
+constexpr auto make_zero_order_hold(Iterator first, Iterator last)
+{
+    return zero_order_hold<Iterator>{first, last};
+}
+
+template <class Container>
+constexpr auto make_zero_order_hold(const Container& inputs)
+{
+    return make_zero_order_hold(std::begin(inputs), std::end(inputs));
+}
+
+/// @brief Evaluates an input every `period` from the time and the state at that time, holding
+/// it until the next evaluation
+/// @tparam Generator callable as `g(t, x)`, returning the input to apply from time `t` given the
+/// state `x` at that time, such as a sampled controller
+/// @note Inputs are evaluated lazily as integration reaches each period.
+template <class Input, class Duration, class Generator>
+class generated_input {
+  public:
+    using duration_type = Duration;
+    using input_type = Input;
+
+    static_assert(tmp::is_specialization_of<duration_type, std::chrono::duration>::value,
+                  "The period of a generated input must be a `std::chrono::duration`.");
+
+    constexpr generated_input(duration_type period, Generator g)
+        : period_{period}, generator_{std::move(g)}
+    {
+        assert(period > duration_type{});
+    }
+
+    template <class State>
+    constexpr auto start(const State& x0) -> void
+    {
+        next_ = duration_type{};
+        advance(x0);
+    }
+
+    constexpr auto input() const noexcept -> const input_type& { return input_; }
+
+    constexpr auto has_next_change() const noexcept -> bool { return true; }
+
+    constexpr auto next_change() const noexcept -> duration_type { return next_; }
+
+    template <class State>
+    constexpr auto advance(const State& x) -> void
+    {
+        input_ = generator_(next_, x);
+        next_ += period_;
+    }
+
+  private:
+    duration_type period_;
+    Generator generator_;
+    input_type input_ = {};
+    duration_type next_ = {};
+};
+
+template <class Input, class Duration, class Generator>
+constexpr auto make_generated_input(Duration period, Generator g)
+{
+    return generated_input<Input, Duration, Generator>{period, std::move(g)};
+}
+
+}  // namespace ode
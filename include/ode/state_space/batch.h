@@ -0,0 +1,218 @@
+#pragma once
+
+#include "ode/state_space/vector.h"
+#include "ode/tmp/type_traits.h"
+#include "units.h"
+
+#include <array>
+#include <cstddef>
+#include <tuple>
+#include <utility>
+
+namespace ode {
+namespace state_space {
+
+namespace detail {
+
+template <std::size_t Lanes>
+struct column {
+    template <class T>
+    struct apply {
+        using type = std::array<T, Lanes>;
+    };
+};
+
+}  // namespace detail
+
+/// @brief A fixed-width ensemble of `state_space::vector`s stored as a structure of arrays
+/// @tparam Vector specialization of `state_space::vector`
+/// @tparam Lanes number of vectors stored
+/// @note Each vector key is stored as a contiguous column. Arithmetic operations loop over all
+/// lanes of a column with a compile-time trip count so they may be vectorized, while the unit of
+/// each column is still checked at compile time.
+template <class Vector, std::size_t Lanes>
+class batch {
+  private:
+    static_assert(tmp::is_specialization_of<Vector, vector>::value,
+                  "`Vector` must be a specialization of `state_space::vector`.");
+    static_assert(Lanes > 0, "A batch requires more than zero lanes.");
+
+    using key_index_mapping = typename Vector::key_index_mapping;
+
+    template <class T>
+    using enable_if_key = typename Vector::template enable_if_key<T>;
+
+  public:
+    using value_type = Vector;
+    using data_type = tmp::rebind_outer<
+        tmp::map<detail::column<Lanes>::template apply, typename Vector::values>,
+        std::tuple>;
+
+    static constexpr std::size_t size = Lanes;
+
+    template <int N = 1>
+    using derivative = batch<typename Vector::template derivative<N>, Lanes>;
+
+    constexpr batch() = default;
+
+    /// Gather a single lane into a `vector`
+    constexpr auto operator[](std::size_t lane) const -> value_type
+    {
+        return gather_impl(lane, std::make_index_sequence<Vector::size>{});
+    }
+
+    /// Scatter a `vector` into a single lane
+    constexpr auto assign(std::size_t lane, const value_type& v) -> void
+    {
+        scatter_impl(lane, v, std::make_index_sequence<Vector::size>{});
+    }
+
+    template <class T, class = enable_if_key<T>>
+    constexpr decltype(auto) column()
+    {
+        using Index = typename key_index_mapping::template at_key<T*>;
+        return std::get<Index::value>(data_);
+    }
+
+    template <class T, class = enable_if_key<T>>
+    constexpr decltype(auto) column() const
+    {
+        using Index = typename key_index_mapping::template at_key<T*>;
+        return std::get<Index::value>(data_);
+    }
+
+    constexpr auto operator+=(const batch& other) -> batch&
+    {
+        add_to_impl(other, std::make_index_sequence<Vector::size>{});
+
+        return *this;
+    }
+
+    template <class Scalar>
+    constexpr auto operator*=(Scalar a)
+        -> std::enable_if_t<units::traits::is_dimensionless_unit<Scalar>::value, batch&>
+    {
+        scale_impl(a, std::make_index_sequence<Vector::size>{});
+
+        return *this;
+    }
+
+    template <class Duration>
+    constexpr auto operator*(Duration dt) const
+        -> std::enable_if_t<std::is_convertible<Duration, detail::implicit_duration_type>::value,
+                            derivative<-1>>
+    {
+        return multiply_by_time_impl(detail::seconds_t<Duration>{dt},
+                                     std::make_index_sequence<Vector::size>{});
+    }
+
+  private:
+    template <std::size_t... Is>
+    constexpr auto gather_impl(std::size_t lane, std::index_sequence<Is...>) const -> value_type
+    {
+        return {std::get<Is>(data_)[lane]...};
+    }
+
+    template <std::size_t... Is>
+    constexpr auto scatter_impl(std::size_t lane, const value_type& v, std::index_sequence<Is...>)
+        -> void
+    {
+        const auto unused = {(std::get<Is>(data_)[lane] = v.template at<Is>(), 0)...};
+        (void)unused;
+    }
+
+    template <class Column>
+    static constexpr auto add_column(Column& lhs, const Column& rhs) -> void
+    {
+        for (auto i = std::size_t{}; i < Lanes; ++i) {
+            lhs[i] += rhs[i];
+        }
+    }
+
+    template <class Column, class Scalar>
+    static constexpr auto scale_column(Column& lhs, Scalar a) -> void
+    {
+        for (auto i = std::size_t{}; i < Lanes; ++i) {
+            lhs[i] *= a;
+        }
+    }
+
+    template <class Integral, class Column, class Duration>
+    static constexpr auto multiply_column_by_time(Integral& integral,
+                                                  const Column& lhs,
+                                                  Duration dt) -> void
+    {
+        for (auto i = std::size_t{}; i < Lanes; ++i) {
+            integral[i] += lhs[i] * dt;
+        }
+    }
+
+    template <std::size_t... Is>
+    constexpr auto add_to_impl(const batch& other, std::index_sequence<Is...>) -> void
+    {
+        const auto unused = {(add_column(std::get<Is>(data_), std::get<Is>(other.data_)), 0)...};
+        (void)unused;
+    }
+
+    template <class Scalar, std::size_t... Is>
+    constexpr auto scale_impl(Scalar a, std::index_sequence<Is...>) -> void
+    {
+        const auto unused = {(scale_column(std::get<Is>(data_), a), 0)...};
+        (void)unused;
+    }
+
+    template <class Duration, std::size_t... Is>
+    constexpr auto multiply_by_time_impl(Duration dt, std::index_sequence<Is...>) const
+        -> derivative<-1>
+    {
+        auto integral = derivative<-1>{};
+
+        const auto unused = {
+            (multiply_column_by_time(std::get<Is>(integral.data_), std::get<Is>(data_), dt), 0)...};
+        (void)unused;
+
+        return integral;
+    }
+
+    data_type data_ = {};
+
+    template <class, std::size_t>
+    friend class batch;
+};
+
+template <class T>
+struct is_batch : std::false_type {};
+
+template <class Vector, std::size_t Lanes>
+struct is_batch<batch<Vector, Lanes>> : std::true_type {};
+
+template <class Batch>
+constexpr auto operator+(const Batch& x, const Batch& y)
+    -> std::enable_if_t<is_batch<Batch>::value, Batch>
+{
+    auto z = x;
+    return z += y;
+}
+
+template <class Scalar, class Batch>
+constexpr auto operator*(Scalar a, const Batch& x)
+    -> std::enable_if_t<is_batch<Batch>::value &&
+                            units::traits::is_dimensionless_unit<Scalar>::value,
+                        Batch>
+{
+    auto y = x;
+    return y *= a;
+}
+
+template <class Duration, class Batch>
+constexpr auto operator*(Duration t, const Batch& x)
+    -> std::enable_if_t<is_batch<Batch>::value &&
+                            !units::traits::is_dimensionless_unit<Duration>::value &&
+                            std::is_convertible<Duration, detail::implicit_duration_type>::value,
+                        typename Batch::template derivative<-1>>
+{
+    return x * t;
+}
+
+}  // namespace state_space
+}  // namespace ode
@@ -0,0 +1,105 @@
+#pragma once
+
+#include "ode/state_space/vector.h"
+#include "ode/thread_pool.h"
+#include "ode/tmp/type_traits.h"
+
+#include <cassert>
+#include <cstddef>
+#include <vector>
+
+namespace ode {
+namespace state_space {
+
+/// @brief Reduces a trajectory to its last state
+template <class State>
+struct final_state {
+    using result_type = State;
+
+    constexpr auto initial(const State& x0) const -> result_type { return x0; }
+
+    template <class Time>
+    constexpr auto operator()(result_type& r, Time, const State& x) const -> void
+    {
+        r = x;
+    }
+};
+
+/// @brief Reduces a trajectory to the minimum and maximum value of each key
+template <class State>
+struct key_bounds {
+    struct result_type {
+        State min;
+        State max;
+    };
+
+    constexpr auto initial(const State& x0) const -> result_type { return {x0, x0}; }
+
+    template <class Time>
+    constexpr auto operator()(result_type& r, Time, const State& x) const -> void
+    {
+        r.min.for_each(elementwise_min{}, x);
+        r.max.for_each(elementwise_max{}, x);
+    }
+
+  private:
+    struct elementwise_min {
+        template <class T>
+        constexpr auto operator()(T& lhs, const T& rhs) const -> void
+        {
+            if (rhs < lhs) {
+                lhs = rhs;
+            }
+        }
+    };
+
+    struct elementwise_max {
+        template <class T>
+        constexpr auto operator()(T& lhs, const T& rhs) const -> void
+        {
+            if (lhs < rhs) {
+                lhs = rhs;
+            }
+        }
+    };
+};
+
+/// @brief Integrate an ensemble of initial states, each with its own input, across a thread pool
+/// and reduce each trajectory of `integrate_range`
+/// @tparam Reducer provides `initial(x0) -> result_type` and is called as `reduce(r, t, x)` for
+/// each state of a trajectory
+/// @note Each trajectory is integrated and reduced by a single thread and its result is written
+/// to its own element of the returned vector without synchronization. Results are therefore
+/// bitwise identical for any number of threads. Reductions across trajectories should be applied
+/// to the returned results in order to preserve this property.
+/// @note The transition function of `sys` is evaluated concurrently. The first exception thrown
+/// integrating a trajectory, such as a `stepper::step_error`, is rethrown once every thread has
+/// stopped, and the trajectories not yet started are skipped.
+template <template <class...> class Stepper, class System, class IntegrationStep, class Reducer>
+auto integrate_ensemble(thread_pool& pool,
+                        const System& sys,
+                        const std::vector<typename System::state>& x0,
+                        const std::vector<typename System::input>& u,
+                        tmp::type_identity_t<IntegrationStep> span,
+                        IntegrationStep step,
+                        Reducer reduce) -> std::vector<typename Reducer::result_type>
+{
+    assert(x0.size() == u.size());
+
+    auto results = std::vector<typename Reducer::result_type>(x0.size());
+
+    pool.parallel_for(x0.size(), [&](std::size_t i) {
+        auto r = reduce.initial(x0[i]);
+
+        for (const auto& sample : sys.template integrate_range<Stepper>(x0[i], u[i], span, step)) {
+            reduce(r, sample.first, sample.second);
+        }
+
+        results[i] = r;
+    });
+
+    return results;
+}
+
+}  // namespace state_space
+}  // namespace ode
@@ -0,0 +1,242 @@
+#pragma once
+
+#include "ode/autodiff.h"
+#include "ode/state_space/vector.h"
+#include "ode/tmp/type_traits.h"
+
+#include <cstddef>
+#include <ostream>
+#include <tuple>
+#include <utility>
+
+namespace ode {
+namespace state_space {
+
+namespace detail {
+
+template <class Vector>
+using keys_of = tmp::skip<1, tmp::rebind_outer<Vector, vector, tmp::list>>;
+
+template <class Vector>
+using values_of = tmp::skip<1, tmp::drop<1, tmp::rebind_outer<Vector, vector, tmp::list>>>;
+
+template <class Vector>
+struct value_list {
+    using type = values_of<Vector>;
+};
+
+template <class Output>
+struct jacobian_row {
+    template <class Input>
+    struct apply {
+        using type = autodiff::partial_t<Output, Input>;
+    };
+};
+
+template <class Input>
+struct make_jacobian_row {
+    template <class Output>
+    struct apply {
+        using type = tmp::rebind_outer<tmp::map<jacobian_row<Output>::template apply,
+                                                values_of<Input>>,
+                                       tmp::list,
+                                       std::tuple>;
+    };
+};
+
+}  // namespace detail
+
+/// @brief Matrix of the partial derivatives of the elements of `Output` with respect to the
+/// elements of `Input`
+/// @note Each entry has the unit of its row element divided by the unit of its column element.
+template <class Output, class Input>
+class jacobian {
+  public:
+    static_assert(tmp::is_specialization_of<Output, vector>::value,
+                  "`Output` must be a specialization of `state_space::vector`.");
+    static_assert(tmp::is_specialization_of<Input, vector>::value,
+                  "`Input` must be a specialization of `state_space::vector`.");
+
+    using data_type = tmp::rebind_outer<
+        tmp::map<detail::make_jacobian_row<Input>::template apply, detail::values_of<Output>>,
+        tmp::list,
+        std::tuple>;
+
+    static constexpr std::size_t rows = Output::size;
+    static constexpr std::size_t columns = Input::size;
+
+    constexpr jacobian() = default;
+
+    constexpr jacobian(const data_type& data) : data_{data} {}
+
+    /// Partial derivative of the element of key `Row` with respect to the element of key `Column`
+    template <class Row, class Column>
+    constexpr decltype(auto) get()
+    {
+        return std::get<Input::template key_index<Column>::value>(
+            std::get<Output::template key_index<Row>::value>(data_));
+    }
+
+    template <class Row, class Column>
+    constexpr decltype(auto) get() const
+    {
+        return std::get<Input::template key_index<Column>::value>(
+            std::get<Output::template key_index<Row>::value>(data_));
+    }
+
+    constexpr auto data() const -> const data_type& { return data_; }
+
+    /// Visit each entry with its row and column index, in row-major order
+    template <class Visitor>
+    constexpr auto for_each(Visitor v) const -> void
+    {
+        for_each_row(v, std::make_index_sequence<rows>{});
+    }
+
+  private:
+    template <class Visitor, std::size_t... Is>
+    constexpr auto for_each_row(Visitor& v, std::index_sequence<Is...>) const -> void
+    {
+        const auto unused = {(for_each_column<Is>(v, std::make_index_sequence<columns>{}), 0)...};
+        (void)unused;
+    }
+
+    template <std::size_t I, class Visitor, std::size_t... Js>
+    constexpr auto for_each_column(Visitor& v, std::index_sequence<Js...>) const -> void
+    {
+        const auto unused = {(v(I, Js, std::get<Js>(std::get<I>(data_))), 0)...};
+        (void)unused;
+    }
+
+    data_type data_;
+};
+
+/// @brief Jacobians of an `Output` with respect to a state and an input
+template <class Output, class State, class Input>
+struct linearization {
+    jacobian<Output, State> a;
+    jacobian<Output, Input> b;
+};
+
+namespace detail {
+
+/// @brief Forward-mode differentiation with respect to the elements of a list of vectors
+/// @note The elements of each vector are seeded in order, followed by the elements of the next.
+template <class Vectors, class Seeds = tmp::concat<tmp::map<value_list, Vectors>>>
+struct differentiation;
+
+template <class... Vectors, class... Seeds>
+struct differentiation<tmp::list<Vectors...>, tmp::list<Seeds...>> {
+  private:
+    template <class Value>
+    struct make_dual {
+        using type = autodiff::dual<Value, Seeds...>;
+    };
+
+  public:
+    template <std::size_t I>
+    using vector_at = std::tuple_element_t<I, std::tuple<Vectors...>>;
+
+    template <class Vector>
+    using dual_vector = tmp::rebind_outer<
+        tmp::interleave<keys_of<Vector>, tmp::map<make_dual, values_of<Vector>>>,
+        vector>;
+
+    /// Seed the elements of the `I`-th vector as independent variables
+    template <std::size_t I>
+    static constexpr auto seed(const vector_at<I>& x) -> dual_vector<vector_at<I>>
+    {
+        auto d = dual_vector<vector_at<I>>{};
+        d.for_each(seeder{offset(I)}, x);
+        return d;
+    }
+
+    /// Jacobian of an output with respect to the `I`-th vector
+    template <std::size_t I, class Output>
+    static constexpr auto extract(const dual_vector<Output>& y) -> jacobian<Output, vector_at<I>>
+    {
+        return extract_impl<Output, vector_at<I>, offset(I)>(
+            y, keys_of<Output>{}, std::make_index_sequence<vector_at<I>::size>{});
+    }
+
+  private:
+    struct seeder {
+        template <class Dual, class Value>
+        constexpr auto operator()(Dual& d, const Value& v) -> void
+        {
+            d = Dual::variable(v, index++);
+        }
+
+        std::size_t index;
+    };
+
+    static constexpr auto offset(std::size_t i) -> std::size_t
+    {
+        const std::size_t sizes[] = {Vectors::size...};
+
+        auto n = std::size_t{};
+        for (auto j = std::size_t{}; j < i; ++j) {
+            n += sizes[j];
+        }
+        return n;
+    }
+
+    template <std::size_t Offset, class Dual, std::size_t... Is>
+    static constexpr auto slice(const Dual& d, std::index_sequence<Is...>)
+    {
+        return std::make_tuple(d.template partial<Offset + Is>()...);
+    }
+
+    template <class Output, class Input, std::size_t Offset, class... Keys, std::size_t... Is>
+    static constexpr auto extract_impl(const dual_vector<Output>& y,
+                                       tmp::list<Keys...>,
+                                       std::index_sequence<Is...> columns)
+        -> jacobian<Output, Input>
+    {
+        return typename jacobian<Output, Input>::data_type{
+            slice<Offset>(y.template get<Keys>(), columns)...};
+    }
+};
+
+}  // namespace detail
+
+namespace detail {
+
+template <class Tuple, class Print, std::size_t... Is>
+auto print_tuple(std::ostream& os, const Tuple& t, Print print, std::index_sequence<Is...>)
+    -> std::ostream&
+{
+    os << "{ ";
+    const auto unused = {(os << (Is == 0 ? "" : ", "), print(os, std::get<Is>(t)), 0)...};
+    (void)unused;
+
+    return os << "}";
+}
+
+struct print_entry {
+    template <class T>
+    auto operator()(std::ostream& os, const T& entry) const -> void
+    {
+        os << entry;
+    }
+};
+
+struct print_row {
+    template <class... Ts>
+    auto operator()(std::ostream& os, const std::tuple<Ts...>& row) const -> void
+    {
+        print_tuple(os, row, print_entry{}, std::index_sequence_for<Ts...>{});
+    }
+};
+
+}  // namespace detail
+
+template <class Output, class Input>
+auto operator<<(std::ostream& os, const jacobian<Output, Input>& j) -> std::ostream&
+{
+    return detail::print_tuple(
+        os, j.data(), detail::print_row{}, std::make_index_sequence<Output::size>{});
+}
+
+}  // namespace state_space
+}  // namespace ode
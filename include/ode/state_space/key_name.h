@@ -0,0 +1,55 @@
+#pragma once
+
+#include "ode/tmp/type_traits.h"
+
+#include <array>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace ode {
+namespace state_space {
+namespace detail {
+
+template <class Key, class = void>
+struct has_static_name : std::false_type {};
+
+template <class Key>
+struct has_static_name<Key, tmp::void_t<decltype(Key::name())>>
+    : std::is_convertible<decltype(Key::name()), const char*> {};
+
+}  // namespace detail
+
+/// @brief Name of a vector key recorded in a trajectory file and identifying the keys of a wire
+/// message
+/// @note A key written to a trajectory file or sent as a wire message must be named, either by
+/// declaring `static constexpr auto name() -> const char*` in the key or by specializing
+/// `key_name` with a `static constexpr auto get() -> const char*`. Names are not derived from
+/// the type of a key, as those depend on the compiler.
+template <class Key>
+struct key_name {
+    static_assert(detail::has_static_name<Key>::value,
+                  "A key written to a trajectory file or a wire message requires a name. Declare "
+                  "`static constexpr auto name() -> const char*` in the key or specialize "
+                  "`ode::state_space::key_name`.");
+
+    static constexpr auto get() -> const char* { return Key::name(); }
+};
+
+namespace detail {
+
+template <class... Keys>
+constexpr auto static_key_names(tmp::list<Keys...>) -> std::array<const char*, sizeof...(Keys)>
+{
+    return {{key_name<Keys>::get()...}};
+}
+
+template <class... Keys>
+auto key_names(tmp::list<Keys...>) -> std::vector<std::string>
+{
+    return {key_name<Keys>::get()...};
+}
+
+}  // namespace detail
+}  // namespace state_space
+}  // namespace ode
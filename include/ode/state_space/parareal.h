@@ -0,0 +1,172 @@
+#pragma once
+
+#include "ode/thread_pool.h"
+#include "ode/tmp/type_traits.h"
+
+#include <cassert>
+#include <cstddef>
+#include <vector>
+
+namespace ode {
+namespace state_space {
+
+/// @brief States at the boundaries of the time slices of a Parareal integration
+template <class State>
+struct parareal_result {
+    /// `slices + 1` states, starting with the initial state and ending with the final state
+    std::vector<State> states;
+
+    /// Number of corrections, each integrating every unconverged slice with the fine stepper
+    std::size_t iterations;
+
+    /// True if the last correction changed no state by more than the tolerance
+    bool converged;
+};
+
+namespace detail {
+
+/// Integrate from `x` for `span` in steps of `step`, ending with a shorter step if `step` does not
+/// divide `span`
+/// @note `integrate_range` prepares the input once but does not visit the state at `span`, which
+/// is reached with a single step from the last state visited.
+template <template <class...> class Stepper, class System, class Duration>
+auto propagate(const System& sys,
+               typename System::state x,
+               const typename System::input& u,
+               Duration span,
+               Duration step) -> typename System::state
+{
+    auto elapsed = Duration{};
+
+    for (const auto& sample : sys.template integrate_range<Stepper>(x, u, span, step)) {
+        elapsed = sample.first;
+        x = sample.second;
+    }
+
+    return (elapsed < span) ? sys.template integrate<Stepper>(x, u, span - elapsed) : x;
+}
+
+struct parareal_correction {
+    template <class T>
+    constexpr auto operator()(T& fine, const T& coarse, const T& previous_coarse) const -> void
+    {
+        fine = fine + (coarse - previous_coarse);
+    }
+};
+
+template <class State>
+auto within_tolerance(const State& x, const State& y, const State& tolerance) -> bool
+{
+    auto within = true;
+
+    x.for_each(
+        [&within](const auto& a, const auto& b, const auto& tol) {
+            within = within && !((tol < a - b) || (tol < b - a));
+        },
+        y,
+        tolerance);
+
+    return within;
+}
+
+}  // namespace detail
+
+/// @brief Integrate a single trajectory in parallel in time with the Parareal algorithm
+/// @tparam Coarse stepper of the serial coarse propagator, cheap and applied with `coarse_step`
+/// @tparam Fine stepper of the parallel fine propagator, applied with `fine_step`
+/// @param slices number of time slices of equal length that `span` is divided into, the last
+/// slice also covering any remainder. Usually a multiple of the number of threads of `pool`.
+/// @param tolerance largest absolute change of each key of a state at any slice boundary for
+/// which the iteration has converged
+/// @param max_iterations largest number of corrections. The states of the first `k` slices equal
+/// the states of a serial integration with `Fine` after `k` corrections, so at most `slices`
+/// corrections are performed.
+/// @note Each correction integrates the slices that are not yet exact with `Fine` across `pool`
+/// and then sweeps over the slices in order with `Coarse`. With `k` corrections, the work is
+/// about `k` times that of a serial integration with `Fine`, divided over the threads, so the
+/// speedup is bounded by `slices / k`.
+/// @note Results do not depend on the number of threads, since each slice is integrated by a
+/// single thread. The transition function of `sys` is evaluated concurrently.
+/// @note The first exception thrown by a fine propagation, such as a `stepper::step_error` of an
+/// adaptive `Fine`, is rethrown once every thread of `pool` has stopped.
+template <template <class...> class Coarse,
+          template <class...> class Fine,
+          class System,
+          class IntegrationStep>
+auto integrate_parareal(thread_pool& pool,
+                        const System& sys,
+                        const typename System::state& x0,
+                        const typename System::input& u,
+                        tmp::type_identity_t<IntegrationStep> span,
+                        std::size_t slices,
+                        tmp::type_identity_t<IntegrationStep> coarse_step,
+                        IntegrationStep fine_step,
+                        const typename System::state& tolerance,
+                        std::size_t max_iterations) -> parareal_result<typename System::state>
+{
+    using state = typename System::state;
+
+    assert(slices > 0);
+    assert(coarse_step > IntegrationStep{});
+    assert(fine_step > IntegrationStep{});
+
+    using rep = typename IntegrationStep::rep;
+
+    const auto width = IntegrationStep{span / static_cast<rep>(slices)};
+    const auto length = [&](std::size_t n) {
+        return (n + 1 < slices) ? width : IntegrationStep{span - width * static_cast<rep>(n)};
+    };
+    const auto coarse = [&](std::size_t n, const state& x) {
+        return detail::propagate<Coarse>(sys, x, u, length(n), coarse_step);
+    };
+
+    auto result = parareal_result<state>{{}, 0, false};
+    result.states.reserve(slices + 1);
+    result.states.push_back(x0);
+
+    // coarse propagation of the states of the previous iteration
+    auto predicted = std::vector<state>{};
+    predicted.reserve(slices);
+
+    for (auto n = std::size_t{}; n < slices; ++n) {
+        predicted.push_back(coarse(n, result.states[n]));
+        result.states.push_back(predicted.back());
+    }
+
+    auto refined = predicted;
+    auto first = std::size_t{};
+
+    while ((first < slices) && (result.iterations < max_iterations) && !result.converged) {
+        pool.parallel_for(slices - first, [&](std::size_t i) {
+            const auto n = first + i;
+            refined[n] = detail::propagate<Fine>(sys, result.states[n], u, length(n), fine_step);
+        });
+
+        ++result.iterations;
+        result.converged = true;
+
+        // the state at the start of slice `first` is exact, so its coarse propagation cancels
+        // and the state at its end is the fine propagation
+        for (auto n = first; n < slices; ++n) {
+            const auto g = coarse(n, result.states[n]);
+
+            refined[n].for_each(detail::parareal_correction{}, g, predicted[n]);
+            const auto within =
+                detail::within_tolerance(refined[n], result.states[n + 1], tolerance);
+
+            result.converged = result.converged && within;
+
+            predicted[n] = g;
+            result.states[n + 1] = refined[n];
+        }
+
+        ++first;
+    }
+
+    result.converged = result.converged || (first == slices);
+
+    return result;
+}
+
+}  // namespace state_space
+}  // namespace ode
@@ -0,0 +1,501 @@
+#pragma once
+
+#include "ode/iterator.h"
+#include "ode/state_space/wire_format.h"
+#include "ode/tmp/type_traits.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <new>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace ode {
+namespace state_space {
+
+/// @brief Error creating or opening a shared trajectory
+class shared_trajectory_error : public std::runtime_error {
+  public:
+    using std::runtime_error::runtime_error;
+};
+
+/// Result of reading a sample from a shared trajectory
+enum class read_status {
+    /// A sample was read
+    value,
+    /// No sample has been published since the last read
+    empty,
+    /// Samples were overwritten before they were read and have been skipped
+    overrun,
+};
+
+namespace detail {
+namespace shared_trajectory {
+
+static_assert(ATOMIC_LLONG_LOCK_FREE == 2,
+              "Shared trajectories require lock-free 64-bit atomics, which are address-free.");
+
+// Shared memory layout, in native byte order:
+//
+// header
+//   magic                uint32, written last once the ring is initialized
+//   version              uint32
+//   fingerprint          uint64
+//   keys                 uint64, hash of the key names of State
+//   capacity             uint64
+//   slot size            uint64
+// written                uint64, number of samples published, on its own cache line
+// slots                  capacity slots, each on its own cache lines
+//   sequence             uint64
+//   elapsed              Duration::rep
+//   state                wire_message<State>
+//
+// Sample `n` is written to slot `n % capacity`. Its sequence is `2n + 1` while the sample is
+// written and `2n + 2` once it is complete, so a reader detects a slot overwritten before or while
+// it is copied from the sequence alone. The sample is written and read as 64-bit words with
+// relaxed atomic operations, so a copy that races with the publisher is discarded rather than
+// being a data race.
+
+constexpr std::uint32_t magic = 0x5253444f;  // "ODSR"
+constexpr std::uint32_t version = 2;
+constexpr std::size_t cache_line = 64;
+
+struct header {
+    std::atomic<std::uint32_t> magic;
+    std::uint32_t version;
+    std::uint64_t fingerprint;
+    std::uint64_t keys;
+    std::uint64_t capacity;
+    std::uint64_t slot_size;
+};
+
+template <class State, class Duration>
+struct sample {
+    typename Duration::rep elapsed;
+    wire_message<State> state;
+};
+
+/// A sample stored as 64-bit words
+template <class Sample>
+struct words {
+    static_assert(std::is_trivially_copyable<Sample>::value, "");
+
+    static constexpr std::size_t size =
+        (sizeof(Sample) + sizeof(std::uint64_t) - 1) / sizeof(std::uint64_t);
+
+    auto store(const Sample& s) noexcept -> void
+    {
+        std::uint64_t buffer[size] = {};
+        std::memcpy(buffer, &s, sizeof(s));
+
+        for (auto i = std::size_t{}; i < size; ++i) {
+            data[i].store(buffer[i], std::memory_order_relaxed);
+        }
+    }
+
+    auto load() const noexcept -> Sample
+    {
+        std::uint64_t buffer[size] = {};
+        for (auto i = std::size_t{}; i < size; ++i) {
+            buffer[i] = data[i].load(std::memory_order_relaxed);
+        }
+
+        auto s = Sample{};
+        std::memcpy(&s, buffer, sizeof(s));
+        return s;
+    }
+
+    std::atomic<std::uint64_t> data[size];
+};
+
+template <class Sample>
+struct alignas(cache_line) slot {
+    std::atomic<std::uint64_t> sequence;
+    words<Sample> sample;
+};
+
+template <class Sample, std::size_t Capacity>
+struct ring {
+    header info;
+    alignas(cache_line) std::atomic<std::uint64_t> written;
+    slot<Sample> slots[Capacity];
+};
+
+template <class State, class Duration>
+constexpr auto fingerprint() -> std::uint64_t
+{
+    using period = typename Duration::period;
+
+    auto h = wire_format::hash(wire_message<State>::fingerprint, sizeof(typename Duration::rep));
+    h = wire_format::hash(h, std::is_floating_point<typename Duration::rep>::value);
+    h = wire_format::hash(h, static_cast<std::uint64_t>(period::num));
+    return wire_format::hash(h, static_cast<std::uint64_t>(period::den));
+}
+
+/// Index of the oldest sample that cannot be overwritten while it is read, given `written`
+/// published samples
+template <std::size_t Capacity>
+constexpr auto oldest(std::uint64_t written) noexcept -> std::uint64_t
+{
+    return (written >= Capacity) ? (written - Capacity + 1) : 0;
+}
+
+}  // namespace shared_trajectory
+}  // namespace detail
+
+/// @brief Publishes `(elapsed, state)` samples to a ring buffer in POSIX shared memory
+/// @tparam State type with `wire_traits`, such as a `state_space::vector`
+/// @tparam Duration `std::chrono::duration` of the elapsed time of each sample
+/// @tparam Capacity number of samples held, a power of two
+/// @note There is a single publisher and any number of `trajectory_subscriber`s, each reading
+/// every sample at its own pace. The publisher never waits for subscribers; a subscriber that
+/// falls more than `Capacity` samples behind skips the overwritten samples. Publishing a sample
+/// writes it to the mapping without a system call.
+template <class State, class Duration, std::size_t Capacity>
+class trajectory_publisher {
+    static_assert(tmp::is_specialization_of<Duration, std::chrono::duration>::value,
+                  "`Duration` must be a `std::chrono::duration`.");
+    static_assert((Capacity > 1) && ((Capacity & (Capacity - 1)) == 0),
+                  "`Capacity` must be a power of two greater than one.");
+
+    using sample_type = detail::shared_trajectory::sample<State, Duration>;
+    using ring_type = detail::shared_trajectory::ring<sample_type, Capacity>;
+
+  public:
+    using state_type = State;
+    using duration_type = Duration;
+
+    static constexpr std::size_t capacity = Capacity;
+
+    /// @brief Creates the shared memory object `name`, replacing any existing object
+    /// @note `name` begins with a slash, as required by `shm_open`. Subscribers that opened a
+    /// replaced object do not receive samples from this publisher.
+    explicit trajectory_publisher(std::string name) : name_{std::move(name)}
+    {
+        ::shm_unlink(name_.c_str());
+
+        const auto fd = ::shm_open(name_.c_str(), O_CREAT | O_EXCL | O_RDWR, 0644);
+        if (fd < 0) {
+            throw shared_trajectory_error{"Unable to create shared memory `" + name_ + "`."};
+        }
+
+        if (::ftruncate(fd, sizeof(ring_type)) != 0) {
+            ::close(fd);
+            ::shm_unlink(name_.c_str());
+            throw shared_trajectory_error{"Unable to size shared memory `" + name_ + "`."};
+        }
+
+        auto mapping =
+            ::mmap(nullptr, sizeof(ring_type), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        ::close(fd);
+        if (mapping == MAP_FAILED) {
+            ::shm_unlink(name_.c_str());
+            throw shared_trajectory_error{"Unable to map shared memory `" + name_ + "`."};
+        }
+
+        ring_ = ::new (mapping) ring_type{};
+        ring_->info.version = detail::shared_trajectory::version;
+        ring_->info.fingerprint = detail::shared_trajectory::fingerprint<State, Duration>();
+        ring_->info.keys = wire_message<State>::keys;
+        ring_->info.capacity = Capacity;
+        ring_->info.slot_size = sizeof(detail::shared_trajectory::slot<sample_type>);
+        ring_->info.magic.store(detail::shared_trajectory::magic, std::memory_order_release);
+    }
+
+    trajectory_publisher(trajectory_publisher&& other) noexcept
+        : name_{std::move(other.name_)},
+          ring_{std::exchange(other.ring_, nullptr)},
+          written_{other.written_}
+    {}
+
+    trajectory_publisher(const trajectory_publisher&) = delete;
+    auto operator=(const trajectory_publisher&) -> trajectory_publisher& = delete;
+    auto operator=(trajectory_publisher&&) -> trajectory_publisher& = delete;
+
+    /// Unmaps and removes the shared memory object. Subscribers keep their mappings.
+    ~trajectory_publisher()
+    {
+        if (ring_ != nullptr) {
+            ::munmap(ring_, sizeof(ring_type));
+            ::shm_unlink(name_.c_str());
+        }
+    }
+
+    auto name() const noexcept -> const std::string& { return name_; }
+
+    /// Number of samples published
+    auto size() const noexcept -> std::uint64_t { return written_; }
+
+    auto publish(Duration elapsed, const State& x) noexcept -> void
+    {
+        const auto n = written_;
+        auto& s = ring_->slots[n & (Capacity - 1)];
+
+        auto sample = sample_type{};
+        sample.elapsed = elapsed.count();
+        serialize(x, sample.state);
+
+        s.sequence.store(2 * n + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+
+        s.sample.store(sample);
+
+        s.sequence.store(2 * n + 2, std::memory_order_release);
+        ring_->written.store(n + 1, std::memory_order_release);
+        written_ = n + 1;
+    }
+
+    template <class Sample>
+    auto publish(const Sample& s) noexcept -> void
+    {
+        publish(s.first, s.second);
+    }
+
+  private:
+    std::string name_;
+    ring_type* ring_ = nullptr;
+    std::uint64_t written_ = 0;
+};
+
+template <class State, class Duration, std::size_t Capacity>
+constexpr std::size_t trajectory_publisher<State, Duration, Capacity>::capacity;
+
+/// @brief Reads the samples of a `trajectory_publisher` from shared memory
+/// @note Reading starts from the oldest sample held when the subscriber is opened. A subscriber
+/// only reads the shared memory and does not affect the publisher or other subscribers.
+template <class State, class Duration, std::size_t Capacity>
+class trajectory_subscriber {
+    using sample_type = detail::shared_trajectory::sample<State, Duration>;
+    using ring_type = detail::shared_trajectory::ring<sample_type, Capacity>;
+
+  public:
+    using state_type = State;
+    using duration_type = Duration;
+    using value_type = std::pair<Duration, State>;
+
+    /// @brief Opens the shared memory object `name` created by a publisher
+    /// @throws shared_trajectory_error if the object does not exist or holds samples of another
+    /// state, duration or capacity
+    explicit trajectory_subscriber(const std::string& name)
+    {
+        const auto fd = ::shm_open(name.c_str(), O_RDONLY, 0);
+        if (fd < 0) {
+            throw shared_trajectory_error{"Unable to open shared memory `" + name + "`."};
+        }
+
+        struct stat info {};
+        if ((::fstat(fd, &info) != 0) ||
+            (static_cast<std::size_t>(info.st_size) != sizeof(ring_type))) {
+            ::close(fd);
+            throw shared_trajectory_error{"Shared memory `" + name +
+                                          "` does not have the size of the ring."};
+        }
+
+        auto mapping = ::mmap(nullptr, sizeof(ring_type), PROT_READ, MAP_SHARED, fd, 0);
+        ::close(fd);
+        if (mapping == MAP_FAILED) {
+            throw shared_trajectory_error{"Unable to map shared memory `" + name + "`."};
+        }
+        ring_ = static_cast<const ring_type*>(mapping);
+
+        const auto& h = ring_->info;
+        if (h.magic.load(std::memory_order_acquire) != detail::shared_trajectory::magic) {
+            unmap();
+            throw shared_trajectory_error{"Shared memory `" + name +
+                                          "` is not an initialized trajectory."};
+        }
+
+        if ((h.version != detail::shared_trajectory::version) ||
+            (h.fingerprint != detail::shared_trajectory::fingerprint<State, Duration>()) ||
+            (h.keys != wire_message<State>::keys) ||
+            (h.capacity != Capacity) ||
+            (h.slot_size != sizeof(detail::shared_trajectory::slot<sample_type>))) {
+            unmap();
+            throw shared_trajectory_error{"Shared memory `" + name +
+                                          "` holds samples of another type."};
+        }
+
+        next_ = detail::shared_trajectory::oldest<Capacity>(
+            ring_->written.load(std::memory_order_acquire));
+    }
+
+    trajectory_subscriber(trajectory_subscriber&& other) noexcept
+        : ring_{std::exchange(other.ring_, nullptr)}, next_{other.next_}, lost_{other.lost_}
+    {}
+
+    trajectory_subscriber(const trajectory_subscriber&) = delete;
+    auto operator=(const trajectory_subscriber&) -> trajectory_subscriber& = delete;
+    auto operator=(trajectory_subscriber&&) -> trajectory_subscriber& = delete;
+
+    ~trajectory_subscriber() { unmap(); }
+
+    /// Index of the next sample to read
+    auto position() const noexcept -> std::uint64_t { return next_; }
+
+    /// Number of samples skipped because they were overwritten before they were read
+    auto lost() const noexcept -> std::uint64_t { return lost_; }
+
+    /// Number of samples published and not yet read, including any that will be lost
+    auto available() const noexcept -> std::uint64_t
+    {
+        return ring_->written.load(std::memory_order_acquire) - next_;
+    }
+
+    /// @brief Reads the next sample into `s` without waiting
+    /// @note On `read_status::overrun`, `s` is unchanged and the next read returns the oldest
+    /// sample still held.
+    auto try_read(value_type& s) -> read_status
+    {
+        const auto written = ring_->written.load(std::memory_order_acquire);
+        if (next_ == written) {
+            return read_status::empty;
+        }
+
+        if (next_ < detail::shared_trajectory::oldest<Capacity>(written)) {
+            return skip_overwritten();
+        }
+
+        const auto& source = ring_->slots[next_ & (Capacity - 1)];
+        const auto sequence = 2 * next_ + 2;
+
+        if (source.sequence.load(std::memory_order_acquire) != sequence) {
+            return skip_overwritten();
+        }
+
+        // The copy may race with the publisher overwriting the slot, which is detected by the
+        // sequence changing and discards the copy.
+        const auto copy = source.sample.load();
+        std::atomic_thread_fence(std::memory_order_acquire);
+
+        if (source.sequence.load(std::memory_order_relaxed) != sequence) {
+            return skip_overwritten();
+        }
+
+        ++next_;
+        s.first = Duration{copy.elapsed};
+        s.second = copy.state.value();
+        return read_status::value;
+    }
+
+  private:
+    auto skip_overwritten() noexcept -> read_status
+    {
+        const auto first = detail::shared_trajectory::oldest<Capacity>(
+            ring_->written.load(std::memory_order_acquire));
+
+        if (first > next_) {
+            lost_ += first - next_;
+            next_ = first;
+        }
+        return read_status::overrun;
+    }
+
+    auto unmap() noexcept -> void
+    {
+        if (ring_ != nullptr) {
+            ::munmap(const_cast<ring_type*>(ring_), sizeof(ring_type));
+            ring_ = nullptr;
+        }
+    }
+
+    const ring_type* ring_ = nullptr;
+    std::uint64_t next_ = 0;
+    std::uint64_t lost_ = 0;
+};
+
+/// @brief Publishes each sample of a step range as it is visited
+/// @tparam Sentinel type of the end of the wrapped range, an iterator or a `step_sentinel`
+/// @note A sample is published when it is first dereferenced, or when the iterator is advanced
+/// past it without being dereferenced. Constructing an iterator, such as the begin or end of a
+/// range, publishes nothing.
+template <class Iterator, class Publisher, class Sentinel = Iterator>
+class publishing_iterator {
+  public:
+    using iterator = publishing_iterator;
+
+    using difference_type = typename std::iterator_traits<Iterator>::difference_type;
+    using value_type = typename std::iterator_traits<Iterator>::value_type;
+    using pointer = typename std::iterator_traits<Iterator>::pointer;
+    using reference = typename std::iterator_traits<Iterator>::reference;
+    using iterator_category = std::input_iterator_tag;
+
+    publishing_iterator(Iterator it, Sentinel last, Publisher& publisher)
+        : it_{std::move(it)}, last_{std::move(last)}, publisher_{&publisher}
+    {}
+
+    auto operator++() -> iterator&
+    {
+        publish();
+        ++it_;
+        published_ = false;
+        return *this;
+    }
+
+    auto operator++(int) -> iterator
+    {
+        auto self = *this;
+        ++*this;
+        return self;
+    }
+
+    auto operator==(const publishing_iterator& other) const -> bool { return it_ == other.it_; }
+
+    auto operator!=(const publishing_iterator& other) const -> bool { return !(*this == other); }
+
+    friend auto operator==(const publishing_iterator& it, step_sentinel) -> bool
+    {
+        return it.it_ == it.last_;
+    }
+
+    friend auto operator!=(const publishing_iterator& it, step_sentinel) -> bool
+    {
+        return it.it_ != it.last_;
+    }
+
+    auto operator*() -> reference
+    {
+        publish();
+        return *it_;
+    }
+
+  private:
+    auto publish() -> void
+    {
+        if (!published_ && (it_ != last_)) {
+            const auto s = *it_;
+            publisher_->publish(s.first, s.second);
+            published_ = true;
+        }
+    }
+
+    Iterator it_;
+    Sentinel last_;
+    Publisher* publisher_;
+    bool published_ = false;
+};
+
+/// @brief Wraps a step range, such as one returned by `system::integrate_range`, to publish each
+/// `(elapsed, state)` sample as it is visited
+template <class Range, class Publisher>
+auto make_publishing_range(Range&& range, Publisher& publisher)
+{
+    using iterator =
+        publishing_iterator<decltype(std::begin(range)), Publisher, decltype(std::end(range))>;
+
+    return ode::detail::wrapped_range<iterator, Range, Publisher&>{std::forward<Range>(range),
+                                                                    publisher};
+}
+
+}  // namespace state_space
+}  // namespace ode
@@ -1,22 +1,55 @@
 #pragma once
 
 #include "ode/iterator.h"
+#include "ode/schedule.h"
+#include "ode/state_space/batch.h"
+#include "ode/state_space/jacobian.h"
 #include "ode/state_space/vector.h"
 #include "ode/stepper.h"
 #include "ode/tmp/type_traits.h"
 #include "units.h"
 
+#include <algorithm>
 #include <array>
+#include <cassert>
+#include <cstddef>
 #include <utility>
+#include <vector>
 
 namespace ode {
 namespace state_space {
 
+namespace detail {
+
+/// @brief Checks if a transition function prepares an input of type `Input`, providing the type
+/// of the prepared input as `type`
+template <class TransitionFunction, class Input, class = void>
+struct prepare_result : std::false_type {
+    using type = Input;
+};
+
+template <class TransitionFunction, class Input>
+struct prepare_result<TransitionFunction,
+                      Input,
+                      tmp::void_t<decltype(std::declval<const TransitionFunction&>().prepare(
+                          std::declval<const Input&>()))>> : std::true_type {
+    using type = std::decay_t<decltype(
+        std::declval<const TransitionFunction&>().prepare(std::declval<const Input&>()))>;
+};
+
+}  // namespace detail
+
+/// @tparam Scalar type of the factors with which a stepper combines states and derivatives
+/// @tparam Duration type of the time passed to the transition function and of each step
+/// @note `Scalar` and `Duration` are in the precision of the state by default, so a `float` state
+/// is integrated entirely in `float`. With a `float` state and a `double` `Scalar` and `Duration`
+/// the transition function is evaluated in `float` while time and the combination of each step
+/// are evaluated in `double`, rounding the state to `float` once per step.
 template <class State,
           class Input,
           class TransitionFunction,
-          class Scalar = units::unit_t<units::dimensionless::scalar, double>,
-          class Duration = units::unit_t<units::time::seconds, double>>
+          class Scalar = units::unit_t<units::dimensionless::scalar, detail::real_t<State>>,
+          class Duration = units::unit_t<units::time::seconds, detail::real_t<State>>>
 class system {
   public:
     static_assert(tmp::is_specialization_of<Input, vector>::value,
@@ -49,6 +82,17 @@ class system {
         tmp::void_t<decltype(std::declval<T>()(state(), input(), duration_type()))>>
         : std::true_type {};
 
+    template <class, class = void>
+    struct has_analytic_jacobian : std::false_type {};
+
+    template <class T>
+    struct has_analytic_jacobian<T,
+                                 tmp::void_t<decltype(std::declval<const T&>().jacobian(
+                                     state(), input(), duration_type()))>> : std::true_type {};
+
+    template <class U>
+    using prepare_result = detail::prepare_result<TransitionFunction, U>;
+
     static constexpr bool tf_is_odeint_form = is_tf_odeint_form<TransitionFunction>::value;
     static constexpr bool tf_is_state_space_form =
         is_tf_state_space_form<TransitionFunction>::value;
@@ -68,6 +112,14 @@ class system {
 
     using transition_function_type = TransitionFunction;
 
+    /// Type passed to the transition function in place of the input during integration
+    /// @note A transition function may compute invariants of the input once per integration by
+    /// providing `prepare(u)`, in which case it must also be callable with the prepared object in
+    /// place of the input. Otherwise the input is passed as is.
+    using prepared_input_type = typename prepare_result<input>::type;
+
+    static constexpr std::size_t default_batch_lanes = 8;
+
     template <template <class...> class Stepper>
     using specialize_stepper = Stepper<state,
                                        scalar_type,
@@ -96,12 +148,227 @@ class system {
             adapt_transfer_function(u, stepper::stepper_tag<SpecializedStepper>{}), x0, span, step);
     }
 
+    /// Integrate as `integrate_range`, reporting right-hand side evaluations and steps to
+    /// `observer`, such as a `counting_observer` or `trace_observer`
+    template <template <class...> class Stepper, class IntegrationStep, class Observer>
+    constexpr auto integrate_range(const state& x0,
+                                   const input& u,
+                                   tmp::type_identity_t<IntegrationStep> span,
+                                   IntegrationStep step,
+                                   Observer& observer) const
+    {
+        using SpecializedStepper = specialize_stepper<Stepper>;
+
+        return make_owning_step_range<SpecializedStepper>(
+            adapt_transfer_function(u, stepper::stepper_tag<SpecializedStepper>{}),
+            x0,
+            span,
+            step,
+            observer);
+    }
+
+    /// Integrate with an instance of a stepper specialized with `specialize_stepper`, such as
+    /// an odeint controlled or dense output stepper configured with tolerances
+    template <class Stepper, class IntegrationStep>
+    constexpr auto integrate_range(const Stepper& s,
+                                   const state& x0,
+                                   const input& u,
+                                   tmp::type_identity_t<IntegrationStep> span,
+                                   IntegrationStep step) const
+    {
+        return make_owning_step_range(
+            s, adapt_transfer_function(u, stepper::stepper_tag<Stepper>{}), x0, span, step);
+    }
+
+    template <class Stepper, class IntegrationStep, class Observer>
+    constexpr auto integrate_range(const Stepper& s,
+                                   const state& x0,
+                                   const input& u,
+                                   tmp::type_identity_t<IntegrationStep> span,
+                                   IntegrationStep step,
+                                   Observer& observer) const
+    {
+        return make_owning_step_range(s,
+                                      adapt_transfer_function(u, stepper::stepper_tag<Stepper>{}),
+                                      x0,
+                                      span,
+                                      step,
+                                      observer);
+    }
+
+    /// Integrate with inputs following a schedule, such as a `zero_order_hold` or
+    /// `generated_input`
+    /// @note Steps are taken on a grid of `step` and split at the times the input changes, so
+    /// each step is integrated with a single input. States are visited at the end of each step.
+    /// The range holds a copy of the system.
+    template <template <class...> class Stepper, class Schedule, class IntegrationStep>
+    constexpr auto integrate_schedule(const state& x0,
+                                      Schedule schedule,
+                                      tmp::type_identity_t<IntegrationStep> span,
+                                      IntegrationStep step) const
+    {
+        static_assert(std::is_same<typename Schedule::input_type, input>::value,
+                      "The inputs of a schedule must be of type `input`.");
+
+        return make_scheduled_step_range(input_integrator<specialize_stepper<Stepper>>{*this},
+                                         std::move(schedule),
+                                         x0,
+                                         span,
+                                         step);
+    }
+
+    /// Integrate with a step of `step`, stopping at the zero crossings of event functions of the
+    /// state, such as those returned by `make_event`
+    /// @note Crossings are located on an interpolant of the step in which they occur, so locating
+    /// an event requires no additional steps. An event may replace the input or end integration
+    /// early. The range holds a copy of the system.
+    template <template <class...> class Stepper, class IntegrationStep, class... Events>
+    auto integrate_events(const state& x0,
+                          const input& u,
+                          tmp::type_identity_t<IntegrationStep> span,
+                          IntegrationStep step,
+                          Events... events) const
+    {
+        static_assert(sizeof...(Events) > 0, "`integrate_events` requires at least one event.");
+
+        return make_event_step_range(input_integrator<specialize_stepper<Stepper>>{*this},
+                                     std::make_tuple(std::move(events)...),
+                                     x0,
+                                     u,
+                                     span,
+                                     step);
+    }
+
+    /// Integrate with a step of `step`, sampling the solution every `sample` by interpolating
+    /// within each step
+    /// @note Requires a fixed step stepper providing dense output, such as `runge_kutta4`.
+    /// Adaptive steppers such as `dormand_prince5` take several internal steps per `step` and are
+    /// rejected.
+    template <template <class...> class Stepper, class IntegrationStep>
+    constexpr auto integrate_dense(const state& x0,
+                                   const input& u,
+                                   tmp::type_identity_t<IntegrationStep> span,
+                                   tmp::type_identity_t<IntegrationStep> step,
+                                   IntegrationStep sample) const
+    {
+        using SpecializedStepper = specialize_stepper<Stepper>;
+
+        static_assert(stepper::is_dense_output_stepper<SpecializedStepper>::value,
+                      "`integrate_dense` requires a state space stepper providing dense output.");
+
+        return make_dense_output_range<SpecializedStepper>(
+            adapt_transfer_function(u, stepper::state_space_tag{}), x0, span, step, sample);
+    }
+
+    /// Integrate a single step of `dt` from `x0`
+    /// @note Each call uses a new stepper, so a stepper keeping state between steps, such as
+    /// `dormand_prince5`, starts afresh. Use `integrate_range` to integrate several steps.
     template <template <class...> class Stepper, class IntegrationStep>
     constexpr auto integrate(const state& x0, const input& u, IntegrationStep dt) const -> state
     {
         using SpecializedStepper = specialize_stepper<Stepper>;
 
-        return do_step<SpecializedStepper>(x0, u, dt, stepper::stepper_tag<SpecializedStepper>{});
+        auto s = SpecializedStepper{};
+
+        return do_step(
+            s,
+            adapt_transfer_function(u, stepper::stepper_tag<SpecializedStepper>{}),
+            x0,
+            IntegrationStep{},
+            dt,
+            stepper::stepper_tag<SpecializedStepper>{});
+    }
+
+    /// Integrate an ensemble of initial states, each with its own input, for a fixed number of
+    /// steps. States are processed in blocks of `Lanes` stored as a `batch` so that the stages of
+    /// a state space stepper operate on contiguous columns of all lanes at once.
+    /// @note Requires an explicit fixed step state space stepper, such as `runge_kutta4`,
+    /// `euler` or `classic_runge_kutta4`. Adaptive and implicit steppers are rejected.
+    /// @note Only the arithmetic combining the stages is columnar. The transition function is
+    /// evaluated one lane at a time, gathering each lane of the batch into a `state` and
+    /// scattering its derivative back into the columns.
+    template <template <class...> class Stepper,
+              std::size_t Lanes = default_batch_lanes,
+              class IntegrationStep>
+    auto integrate_batch(const std::vector<state>& x0,
+                         const std::vector<input>& u,
+                         IntegrationStep dt,
+                         std::size_t steps) const -> std::vector<state>
+    {
+        using BatchStepper =
+            Stepper<batch<state, Lanes>, scalar_type, batch<deriv, Lanes>, duration_type>;
+
+        static_assert(stepper::is_state_space_stepper<BatchStepper>::value,
+                      "`integrate_batch` requires a state space stepper.");
+        static_assert(!stepper::is_implicit_stepper<BatchStepper>::value,
+                      "`integrate_batch` does not support implicit steppers.");
+        static_assert(!stepper::is_adaptive_stepper<BatchStepper>::value,
+                      "`integrate_batch` requires a fixed step stepper, such as `runge_kutta4`.");
+        assert(x0.size() == u.size());
+
+        auto x = x0;
+
+        for (auto first = std::size_t{}; first < x.size(); first += Lanes) {
+            const auto n = std::min(Lanes, x.size() - first);
+
+            // Unused lanes in the last block repeat the final trajectory and are discarded.
+            auto xb = batch<state, Lanes>{};
+            auto ub = batch<input, Lanes>{};
+            for (auto i = std::size_t{}; i < Lanes; ++i) {
+                const auto j = first + std::min(i, n - 1);
+                xb.assign(i, x[j]);
+                ub.assign(i, u[j]);
+            }
+
+            const auto f =
+                batch_form<Lanes>{*this, prepare_lanes(ub, std::make_index_sequence<Lanes>{})};
+
+            auto s = BatchStepper{};
+            auto t = duration_type{};
+            for (auto k = std::size_t{}; k < steps; ++k) {
+                xb = s.step(f, xb, t, dt);
+                t += dt;
+            }
+
+            for (auto i = std::size_t{}; i < n; ++i) {
+                x[first + i] = xb[i];
+            }
+        }
+
+        return x;
+    }
+
+    /// Integrate a trajectory of `N` samples spaced by `dt`, starting with `x0` at time zero.
+    /// @note Each sample is integrated from the previous one with the same stepper, so a
+    /// trajectory requires `N - 1` steps and may be evaluated in a constant expression.
+    template <template <class...> class Stepper, std::size_t N, class IntegrationStep>
+    constexpr auto integrate_trajectory(const state& x0, const input& u, IntegrationStep dt) const
+        -> std::array<std::pair<IntegrationStep, state>, N>
+    {
+        static_assert(tmp::is_specialization_of<IntegrationStep, std::chrono::duration>::value,
+                      "");
+
+        using SpecializedStepper = specialize_stepper<Stepper>;
+
+        const auto f = adapt_transfer_function(u, stepper::stepper_tag<SpecializedStepper>{});
+
+        auto s = SpecializedStepper{};
+        auto samples = trajectory_samples<IntegrationStep, N>{};
+
+        auto t = IntegrationStep{};
+        auto x = x0;
+
+        for (auto i = std::size_t{}; i < N; ++i) {
+            samples.t[i] = t;
+            samples.x[i] = x;
+
+            if (i + 1 < N) {
+                x = do_step(s, f, x, t, dt, stepper::stepper_tag<SpecializedStepper>{});
+                t = t + dt;
+            }
+        }
+
+        return make_trajectory_impl(samples, std::make_index_sequence<N>{});
     }
 
     template <template <class...> class Stepper,
@@ -118,84 +385,309 @@ class system {
         constexpr auto steps = SpanType{SpanValue} / dt;
         static_assert(steps >= 0, "");
 
-        return make_trajectory_impl<Stepper>(x0, u, dt, std::make_index_sequence<steps>{});
+        return integrate_trajectory<Stepper, steps>(x0, u, dt);
+    }
+
+    /// Jacobians of the transition function with respect to the state and the input
+    /// @note The Jacobians are evaluated in a single call of the transition function with
+    /// forward-mode automatic differentiation. The transition function must be generic over the
+    /// element types of its state and input, see `autodiff::dual`.
+    auto linearize(const state& x, const input& u, duration_type t = {}) const
+        -> linearization<deriv, state, input>
+    {
+        using differentiation = detail::differentiation<tmp::list<state, input>>;
+
+        const auto dxdt = evaluate(differentiation::template seed<0>(x),
+                                   differentiation::template seed<1>(u),
+                                   t,
+                                   transfer_function_form_tag{});
+
+        return {differentiation::template extract<0, deriv>(dxdt),
+                differentiation::template extract<1, deriv>(dxdt)};
+    }
+
+    /// Jacobians of a step of `dt` with respect to the initial state and the input, i.e. the
+    /// matrices A and B of the discrete-time system x[k + 1] = A x[k] + B u[k] linearized at
+    /// `x` and `u`
+    /// @note The step is differentiated exactly with forward-mode automatic differentiation and
+    /// requires a single integration. See `linearize` for the requirements on the transition
+    /// function.
+    template <template <class...> class Stepper, class IntegrationStep>
+    auto linearize_step(const state& x, const input& u, IntegrationStep dt) const
+        -> linearization<state, state, input>
+    {
+        using differentiation = detail::differentiation<tmp::list<state, input>>;
+        using dual_state = typename differentiation::template dual_vector<state>;
+        using dual_input = typename differentiation::template dual_vector<input>;
+        using DualStepper = Stepper<dual_state,
+                                    scalar_type,
+                                    typename dual_state::template derivative<>,
+                                    duration_type>;
+
+        static_assert(stepper::is_state_space_stepper<DualStepper>::value,
+                      "`linearize_step` requires a state space stepper.");
+
+        const auto f =
+            dual_form<dual_state, dual_input>{*this, differentiation::template seed<1>(u)};
+        const auto x1 =
+            DualStepper{}.step(f, differentiation::template seed<0>(x), IntegrationStep{}, dt);
+
+        return {differentiation::template extract<0, state>(x1),
+                differentiation::template extract<1, state>(x1)};
     }
 
   private:
-    template <class Stepper, class IntegrationStep>
-    auto do_step(state x, const input& u, IntegrationStep dt, stepper::odeint_tag) const -> state
+    template <class U>
+    constexpr auto prepare(const U& u, std::true_type) const
+    {
+        return tf_.prepare(u);
+    }
+
+    template <class U>
+    constexpr auto prepare(const U& u, std::false_type) const -> U
+    {
+        return u;
+    }
+
+    constexpr auto prepare(const input& u) const -> prepared_input_type
+    {
+        return prepare(u, prepare_result<input>{});
+    }
+
+    template <class Stepper, class System, class IntegrationStep>
+    static auto do_step(Stepper& s,
+                        System f,
+                        state x,
+                        IntegrationStep t,
+                        IntegrationStep dt,
+                        stepper::odeint_tag) -> state
     {
-        Stepper{}.do_step(
-            adapt_transfer_function(u, transfer_function_form_tag{}), x, IntegrationStep{}, dt);
+        s.do_step(f, x, t, dt);
 
         return x;
     }
 
-    template <class Stepper, class IntegrationStep>
-    constexpr auto
-    do_step(const state& x0, const input& u, IntegrationStep dt, stepper::state_space_tag tag) const
-        -> state
+    template <class Stepper, class System, class IntegrationStep>
+    static constexpr auto do_step(Stepper& s,
+                                  const System& f,
+                                  const state& x0,
+                                  IntegrationStep t,
+                                  IntegrationStep dt,
+                                  stepper::state_space_tag) -> state
+    {
+        return s.step(f, x0, t, dt);
+    }
+
+    template <class Tag>
+    constexpr auto adapt_transfer_function(const input& u, Tag tag) const
     {
-        return Stepper{}.step(adapt_transfer_function(u, tag), x0, IntegrationStep{}, dt);
+        return adapt_transfer_function(u, prepare(u), tag);
     }
 
-    auto adapt_transfer_function(const input& u, odeint_tf_tag) const { return tf_(u); }
+    auto adapt_transfer_function(const input&, const prepared_input_type& p, odeint_tf_tag) const
+    {
+        return tf_(p);
+    }
 
-    auto adapt_transfer_function(const input& u, state_space_tf_tag) const
+    auto
+    adapt_transfer_function(const input&, const prepared_input_type& p, state_space_tf_tag) const
     {
-        return [this, u](const auto& x, auto& dxdt, auto t) { dxdt = tf_(x, u, t); };
+        return [this, p](const auto& x, auto& dxdt, auto t) { dxdt = tf_(x, p, t); };
     }
 
-    auto adapt_transfer_function(const input& u, stepper::odeint_tag) const
+    auto adapt_transfer_function(const input& u,
+                                 const prepared_input_type& p,
+                                 stepper::odeint_tag) const
     {
-        return adapt_transfer_function(u, odeint_tf_tag{});
+        return adapt_transfer_function(u, p, transfer_function_form_tag{});
     }
 
-    constexpr auto adapt_transfer_function(const input& u, stepper::state_space_tag) const
+    constexpr auto adapt_transfer_function(const input&,
+                                           const prepared_input_type& p,
+                                           stepper::state_space_tag) const
     {
         struct standard_form {
             constexpr auto operator()(duration_type t, const state& x) const -> deriv
             {
-                return tf(x, u, t);
+                return tf(x, p, t);
             }
 
             const transition_function_type& tf;
-            input u;
+            prepared_input_type p;
         };
 
-        return standard_form{tf_, u};
+        return standard_form{tf_, p};
     }
 
-    template <template <class...> class Stepper, class System, class IntegrationStep, std::size_t N>
-    struct invoker {
-        template <std::size_t I = N, std::enable_if_t<I == 0, bool> = true>
-        constexpr auto operator()() const
+    auto adapt_transfer_function(const input& u,
+                                 const prepared_input_type& p,
+                                 stepper::implicit_tag) const
+    {
+        return implicit_form{*this, u, p};
+    }
+
+    /// Steps with an input and its preparation held by an iterator
+    /// @note Holds a copy of the system, so that a range outlives the system it was created from.
+    /// @note Consecutive steps share a stepper, so a stepper keeping state between steps, such as
+    /// `dormand_prince5`, continues from one step to the next. Preparing an input replaces the
+    /// stepper, as its state was computed with the previous input.
+    template <class Stepper>
+    struct input_integrator {
+        using input_type = input;
+        using prepared_input_type = typename system::prepared_input_type;
+        using interpolant_type =
+            stepper::hermite_interpolant<state, scalar_type, deriv, duration_type>;
+
+        auto prepare(const input& u) -> prepared_input_type
         {
-            return x;
+            instance = Stepper{};
+            return sys.prepare(u);
         }
 
-        template <std::size_t I = N, std::enable_if_t<I != 0, bool> = true>
-        constexpr auto operator()() const
+        template <class IntegrationStep>
+        auto step(const state& x,
+                  const input& u,
+                  const prepared_input_type& p,
+                  IntegrationStep t,
+                  IntegrationStep dt) -> state
         {
-            return invoker<Stepper, System, IntegrationStep, I - 1>{
-                system, system.template integrate<Stepper>(x, u, dt), u, dt}();
+            return do_step(
+                instance,
+                sys.adapt_transfer_function(u, p, stepper::stepper_tag<Stepper>{}),
+                x,
+                t,
+                dt,
+                stepper::stepper_tag<Stepper>{});
         }
 
-        const System& system;
-        state x;
+        /// Cubic Hermite interpolant of a step from `x0` to `x1`, evaluating the derivative at
+        /// both ends
+        template <class IntegrationStep>
+        auto interpolate(const state& x0,
+                         const state& x1,
+                         const prepared_input_type& p,
+                         IntegrationStep t,
+                         IntegrationStep dt) const -> interpolant_type
+        {
+            const auto t0 = duration_type{t};
+            const auto h = duration_type{dt};
+
+            return {t0,
+                    h,
+                    x0,
+                    x1,
+                    sys.evaluate(x0, p, t0, transfer_function_form_tag{}),
+                    sys.evaluate(x1, p, t0 + h, transfer_function_form_tag{})};
+        }
+
+        system sys;
+        Stepper instance = {};
+    };
+
+    template <class X, class U>
+    auto evaluate(const X& x, const U& u, duration_type t, odeint_tf_tag) const
+        -> typename X::template derivative<>
+    {
+        auto dxdt = typename X::template derivative<>{};
+        tf_(u)(x, dxdt, t);
+        return dxdt;
+    }
+
+    template <class X, class U>
+    auto evaluate(const X& x, const U& u, duration_type t, state_space_tf_tag) const
+        -> typename X::template derivative<>
+    {
+        return tf_(x, u, t);
+    }
+
+    auto evaluate_jacobian(const state& x, const input& u, duration_type t, std::true_type) const
+        -> state_space::jacobian<deriv, state>
+    {
+        return tf_.jacobian(x, u, t);
+    }
+
+    auto evaluate_jacobian(const state& x, const input& u, duration_type t, std::false_type) const
+        -> state_space::jacobian<deriv, state>
+    {
+        using differentiation = detail::differentiation<tmp::list<state>>;
+
+        return differentiation::template extract<0, deriv>(
+            evaluate(differentiation::template seed<0>(x), u, t, transfer_function_form_tag{}));
+    }
+
+    template <std::size_t Lanes, std::size_t... Is>
+    auto prepare_lanes(const batch<input, Lanes>& u, std::index_sequence<Is...>) const
+        -> std::array<prepared_input_type, Lanes>
+    {
+        return {{prepare(u[Is])...}};
+    }
+
+    template <std::size_t Lanes>
+    struct batch_form {
+        auto operator()(duration_type t, const batch<state, Lanes>& x) const -> batch<deriv, Lanes>
+        {
+            auto dxdt = batch<deriv, Lanes>{};
+
+            for (auto i = std::size_t{}; i < Lanes; ++i) {
+                dxdt.assign(i, sys.evaluate(x[i], p[i], t, transfer_function_form_tag{}));
+            }
+
+            return dxdt;
+        }
+
+        const system& sys;
+        std::array<prepared_input_type, Lanes> p;
+    };
+
+    /// Transition function together with its Jacobian with respect to the state, taken from
+    /// `jacobian(x, u, t)` of the transition function if provided and otherwise evaluated with
+    /// forward-mode automatic differentiation
+    /// @note The Jacobian is evaluated with the input rather than the prepared input, as
+    /// preparing an input need not support automatic differentiation.
+    struct implicit_form {
+        auto operator()(duration_type t, const state& x) const -> deriv
+        {
+            return sys.evaluate(x, p, t, transfer_function_form_tag{});
+        }
+
+        auto jacobian(duration_type t, const state& x) const
+            -> state_space::jacobian<deriv, state>
+        {
+            return sys.evaluate_jacobian(
+                x, u, t, has_analytic_jacobian<transition_function_type>{});
+        }
+
+        const system& sys;
         input u;
-        IntegrationStep dt;
+        prepared_input_type p;
+    };
+
+    template <class DualState, class DualInput>
+    struct dual_form {
+        auto operator()(duration_type t, const DualState& x) const
+            -> typename DualState::template derivative<>
+        {
+            return sys.evaluate(x, u, t, transfer_function_form_tag{});
+        }
+
+        const system& sys;
+        DualInput u;
     };
 
-    template <template <class...> class Stepper, class IntegrationStep, std::size_t... Is>
-    constexpr auto make_trajectory_impl(const state& x0,
-                                        const input& u,
-                                        IntegrationStep dt,
-                                        std::index_sequence<Is...>) const
-        -> std::array<std::pair<IntegrationStep, state>, sizeof...(Is)>
+    /// @note `std::array` and `std::pair` assignment are not `constexpr` until C++17 and C++20,
+    /// so samples are written to built-in arrays before being copied to the result.
+    template <class IntegrationStep, std::size_t N>
+    struct trajectory_samples {
+        IntegrationStep t[N > 0 ? N : 1];
+        state x[N > 0 ? N : 1];
+    };
+
+    template <class IntegrationStep, std::size_t N, std::size_t... Is>
+    static constexpr auto make_trajectory_impl(
+        const trajectory_samples<IntegrationStep, N>& samples, std::index_sequence<Is...>)
+        -> std::array<std::pair<IntegrationStep, state>, N>
     {
-        return {std::make_pair(
-            Is * dt, invoker<Stepper, system, IntegrationStep, Is>{*this, x0, u, dt}())...};
+        return {{std::make_pair(samples.t[Is], samples.x[Is])...}};
     }
 
     transition_function_type tf_;
@@ -203,21 +695,33 @@ class system {
 
 namespace detail {
 
-template <class State, class Input, class TransitionFunction>
-constexpr auto make_system(State, Input, TransitionFunction&& tf)
-    -> system<std::decay_t<State>, std::decay_t<Input>, std::decay_t<TransitionFunction>>
+template <class State, class Input, class Real, class TransitionFunction>
+using system_with_precision = system<std::decay_t<State>,
+                                     std::decay_t<Input>,
+                                     std::decay_t<TransitionFunction>,
+                                     units::unit_t<units::dimensionless::scalar, Real>,
+                                     units::unit_t<units::time::seconds, Real>>;
+
+template <class State, class Input, class Real, class TransitionFunction>
+constexpr auto make_system(State, Input, Real, TransitionFunction&& tf)
+    -> system_with_precision<State, Input, Real, TransitionFunction>
 {
-    return system<std::decay_t<State>, std::decay_t<Input>, std::decay_t<TransitionFunction>>{
+    return system_with_precision<State, Input, Real, TransitionFunction>{
         std::forward<TransitionFunction>(tf)};
 }
 
 }  // namespace detail
 
-template <class State, class Input, class TransitionFunction>
+/// @tparam Real precision of time and of the combination of each step, by default the
+/// precision of the state. A `double` `Real` with a `float` state integrates in mixed precision.
+template <class State,
+          class Input,
+          class Real = detail::real_t<State>,
+          class TransitionFunction>
 constexpr auto make_system(TransitionFunction&& tf)
-    -> system<std::decay_t<State>, std::decay_t<Input>, std::decay_t<TransitionFunction>>
+    -> detail::system_with_precision<State, Input, Real, TransitionFunction>
 {
-    return detail::make_system(State{}, Input{}, std::forward<TransitionFunction>(tf));
+    return detail::make_system(State{}, Input{}, Real{}, std::forward<TransitionFunction>(tf));
 }
 
 }  // namespace state_space
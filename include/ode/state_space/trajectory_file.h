@@ -0,0 +1,618 @@
+#pragma once
+
+#include "ode/state_space/key_name.h"
+#include "ode/state_space/unit_description.h"
+#include "ode/state_space/vector.h"
+#include "ode/tmp/type_traits.h"
+#include "units.h"
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <ratio>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace ode {
+namespace state_space {
+
+/// @brief Error reading or writing a trajectory file
+class trajectory_file_error : public std::runtime_error {
+  public:
+    using std::runtime_error::runtime_error;
+};
+
+namespace detail {
+namespace trajectory_file {
+
+// File layout, in native byte order:
+//
+// header
+//   magic                char[8]
+//   byte order mark      uint32
+//   version              uint32
+//   rows per block       uint64
+//   key count            uint32
+//   per key
+//     name length        uint32
+//     name               char[name length]
+//     unit               unit_descriptor
+//   padding to a multiple of `alignment`
+//
+// blocks of up to `rows per block` samples, only the last of which may be partial
+//   rows                 uint64
+//   time [s]             double[rows per block]
+//   per key
+//     values             underlying_type[rows per block], padded to a multiple of 8 bytes
+//
+// A partial block is padded to the size of a full block so that a block and each column within
+// it are located without an index.
+
+constexpr char magic[8] = {'O', 'D', 'E', 'T', 'R', 'A', 'J', '\0'};
+constexpr std::uint32_t byte_order_mark = 0x01020304;
+constexpr std::uint32_t version = 1;
+constexpr std::size_t alignment = 64;
+
+constexpr auto pad(std::size_t n, std::size_t to = 8) -> std::size_t
+{
+    return (n + to - 1) / to * to;
+}
+
+/// Dimension exponents of the SI base units, followed by the conversion factor, pi exponent and
+/// translation of a unit, each stored as a numerator and denominator
+struct unit_descriptor {
+    std::uint32_t value_size;
+    value_kind kind;
+    std::int64_t ratios[12][2];
+};
+
+inline auto operator==(const unit_descriptor& lhs, const unit_descriptor& rhs) -> bool
+{
+    return (lhs.value_size == rhs.value_size) && (lhs.kind == rhs.kind) &&
+           (std::memcmp(lhs.ratios, rhs.ratios, sizeof(lhs.ratios)) == 0);
+}
+
+template <class... Ratios>
+constexpr auto fill_ratios(unit_descriptor& d, std::size_t first, tmp::list<Ratios...>) -> void
+{
+    const std::int64_t values[][2] = {{Ratios::num, Ratios::den}...};
+
+    for (auto i = std::size_t{}; i < sizeof...(Ratios); ++i) {
+        d.ratios[first + i][0] = values[i][0];
+        d.ratios[first + i][1] = values[i][1];
+    }
+}
+
+template <class UnitType>
+auto describe() -> unit_descriptor
+{
+    using underlying_type = typename UnitType::underlying_type;
+    using ratios = unit_ratios<UnitType>;
+
+    static_assert(std::is_arithmetic<underlying_type>::value,
+                  "Trajectory files require arithmetic underlying types.");
+
+    auto d = unit_descriptor{};
+    d.value_size = sizeof(underlying_type);
+    d.kind = kind_of<underlying_type>();
+    fill_ratios(d, 0, typename ratios::dimension{});
+    fill_ratios(d, 9, typename ratios::scale{});
+
+    return d;
+}
+
+template <class Vector, std::size_t... Is>
+auto describe_all(std::index_sequence<Is...>) -> std::vector<unit_descriptor>
+{
+    return {describe<typename Vector::template element_type<Is>>()...};
+}
+
+template <class Vector>
+auto describe_all() -> std::vector<unit_descriptor>
+{
+    return describe_all<Vector>(std::make_index_sequence<Vector::size>{});
+}
+
+template <class Vector>
+struct keys_of;
+
+template <class... Args>
+struct keys_of<vector<Args...>> {
+    using type = tmp::skip<1, tmp::list<Args...>>;
+};
+
+}  // namespace trajectory_file
+}  // namespace detail
+
+/// @brief Appends `(time, state)` samples to a columnar binary trajectory file
+/// @tparam Vector specialization of `state_space::vector`
+/// @note Samples are buffered in memory and written a block at a time. Each block stores the
+/// samples of each key contiguously. The final, possibly partial, block is written by `close` or
+/// on destruction.
+/// @note The name of each key, given by `key_name`, is recorded in the header.
+/// @note `close` reports errors writing the final block by throwing. The destructor writes it on
+/// a best effort basis and ignores errors, so call `close` to detect them.
+template <class Vector>
+class trajectory_writer {
+    static_assert(tmp::is_specialization_of<Vector, vector>::value,
+                  "`Vector` must be a specialization of `state_space::vector`.");
+
+  public:
+    static constexpr std::size_t default_block_rows = 4096;
+
+    explicit trajectory_writer(const std::string& path,
+                               std::size_t block_rows = default_block_rows)
+        : file_{path, std::ios::binary | std::ios::trunc}, block_rows_{block_rows}
+    {
+        namespace format = detail::trajectory_file;
+
+        if (!file_) {
+            throw trajectory_file_error{"Unable to open `" + path + "` for writing."};
+        }
+        if (block_rows_ == 0) {
+            throw trajectory_file_error{
+                "A trajectory file requires more than zero rows per block."};
+        }
+
+        const auto names = detail::key_names(typename format::keys_of<Vector>::type{});
+        const auto descriptors = format::describe_all<Vector>();
+
+        file_.write(format::magic, sizeof(format::magic));
+        put(format::byte_order_mark);
+        put(format::version);
+        put(static_cast<std::uint64_t>(block_rows_));
+        put(static_cast<std::uint32_t>(Vector::size));
+
+        for (auto i = std::size_t{}; i < Vector::size; ++i) {
+            put(static_cast<std::uint32_t>(names[i].size()));
+            file_.write(names[i].data(), static_cast<std::streamsize>(names[i].size()));
+            put(descriptors[i]);
+        }
+
+        const auto header_size = static_cast<std::size_t>(file_.tellp());
+        const auto padding = std::vector<char>(format::pad(header_size, format::alignment) -
+                                               header_size);
+        file_.write(padding.data(), static_cast<std::streamsize>(padding.size()));
+
+        times_.reserve(block_rows_ * sizeof(double));
+        columns_.resize(Vector::size);
+        for (auto i = std::size_t{}; i < Vector::size; ++i) {
+            value_sizes_[i] = descriptors[i].value_size;
+            columns_[i].reserve(block_rows_ * value_sizes_[i]);
+        }
+    }
+
+    trajectory_writer(const trajectory_writer&) = delete;
+    auto operator=(const trajectory_writer&) -> trajectory_writer& = delete;
+
+    ~trajectory_writer()
+    {
+        if (file_.is_open()) {
+            try {
+                flush_block();
+            } catch (...) {
+                // a destructor must not throw, possibly during stack unwinding
+            }
+        }
+    }
+
+    /// Append a single sample
+    template <class Time>
+    auto write(Time t, const Vector& x) -> void
+    {
+        append_bytes(times_, units::time::second_t{t}.template to<double>());
+        x.for_each(append{columns_, 0});
+
+        if (++rows_ == block_rows_) {
+            flush_block();
+        }
+    }
+
+    /// Append all samples of a range of `(time, state)` pairs, such as a step range
+    template <class Range>
+    auto write_range(Range&& r) -> void
+    {
+        for (const auto& sample : r) {
+            write(sample.first, sample.second);
+        }
+    }
+
+    /// Write buffered samples and close the file
+    auto close() -> void
+    {
+        flush_block();
+        file_.close();
+
+        if (!file_) {
+            throw trajectory_file_error{"Unable to write trajectory file."};
+        }
+    }
+
+  private:
+    struct append {
+        template <class T>
+        auto operator()(const T& elem) -> void
+        {
+            append_bytes(columns[i++], elem.value());
+        }
+
+        std::vector<std::vector<char>>& columns;
+        std::size_t i;
+    };
+
+    template <class T>
+    static auto append_bytes(std::vector<char>& column, const T& value) -> void
+    {
+        const auto bytes = reinterpret_cast<const char*>(&value);
+        column.insert(column.end(), bytes, bytes + sizeof(value));
+    }
+
+    template <class T>
+    auto put(const T& value) -> void
+    {
+        file_.write(reinterpret_cast<const char*>(&value), sizeof(value));
+    }
+
+    auto write_padded(const std::vector<char>& data, std::size_t value_size) -> void
+    {
+        const auto size = detail::trajectory_file::pad(block_rows_ * value_size);
+
+        file_.write(data.data(), static_cast<std::streamsize>(data.size()));
+        padding_.resize(size - data.size());
+        file_.write(padding_.data(), static_cast<std::streamsize>(padding_.size()));
+    }
+
+    auto flush_block() -> void
+    {
+        if (rows_ == 0) {
+            return;
+        }
+
+        put(static_cast<std::uint64_t>(rows_));
+        rows_ = 0;
+
+        write_padded(times_, sizeof(double));
+        times_.clear();
+
+        for (auto i = std::size_t{}; i < Vector::size; ++i) {
+            write_padded(columns_[i], value_sizes_[i]);
+            columns_[i].clear();
+        }
+
+        if (!file_) {
+            throw trajectory_file_error{"Unable to write trajectory file."};
+        }
+    }
+
+    std::ofstream file_;
+    std::size_t block_rows_;
+    std::size_t rows_ = 0;
+    std::vector<char> times_;
+    std::vector<std::vector<char>> columns_;
+    std::array<std::size_t, Vector::size> value_sizes_ = {};
+    std::vector<char> padding_;
+};
+
+/// @brief A read-only view of a column stored in the blocks of a mapped trajectory file
+/// @tparam T unit type of the column
+/// @note Elements are read directly from the mapping. The values of each block are contiguous and
+/// may be accessed through `data`.
+template <class T>
+class column_view {
+  public:
+    using value_type = T;
+    using underlying_type = typename T::underlying_type;
+
+    class const_iterator {
+      public:
+        using difference_type = std::ptrdiff_t;
+        using value_type = T;
+        using pointer = const T*;
+        using reference = T;
+        using iterator_category = std::input_iterator_tag;
+
+        const_iterator(const column_view& view, std::size_t i) : view_{&view}, i_{i} {}
+
+        auto operator*() const -> T { return (*view_)[i_]; }
+
+        auto operator++() -> const_iterator&
+        {
+            ++i_;
+            return *this;
+        }
+
+        auto operator++(int) -> const_iterator
+        {
+            auto self = *this;
+            ++i_;
+            return self;
+        }
+
+        auto operator==(const const_iterator& other) const -> bool { return i_ == other.i_; }
+        auto operator!=(const const_iterator& other) const -> bool { return !(*this == other); }
+
+      private:
+        const column_view* view_;
+        std::size_t i_;
+    };
+
+    column_view(const char* first_block,
+                std::size_t offset,
+                std::size_t block_size,
+                std::size_t block_rows,
+                std::size_t size)
+        : first_block_{first_block},
+          offset_{offset},
+          block_size_{block_size},
+          block_rows_{block_rows},
+          size_{size}
+    {}
+
+    auto size() const noexcept -> std::size_t { return size_; }
+
+    auto operator[](std::size_t i) const -> T
+    {
+        return T{data(i / block_rows_)[i % block_rows_]};
+    }
+
+    auto block_count() const noexcept -> std::size_t
+    {
+        return (size_ + block_rows_ - 1) / block_rows_;
+    }
+
+    /// Number of values stored in a block
+    auto block_size(std::size_t block) const noexcept -> std::size_t
+    {
+        return std::min(block_rows_, size_ - block * block_rows_);
+    }
+
+    /// Values stored in a block
+    auto data(std::size_t block) const noexcept -> const underlying_type*
+    {
+        return reinterpret_cast<const underlying_type*>(first_block_ + block * block_size_ +
+                                                        offset_);
+    }
+
+    auto begin() const -> const_iterator { return {*this, 0}; }
+    auto end() const -> const_iterator { return {*this, size_}; }
+
+  private:
+    const char* first_block_;
+    std::size_t offset_;
+    std::size_t block_size_;
+    std::size_t block_rows_;
+    std::size_t size_;
+};
+
+/// @brief Maps a trajectory file written by `trajectory_writer` into memory
+/// @tparam Vector specialization of `state_space::vector` the file is read as
+/// @note Construction fails if the number of keys, or the name, underlying type or unit of any
+/// key, does not match `Vector`, as with the header of a wire message.
+template <class Vector>
+class trajectory_reader {
+    static_assert(tmp::is_specialization_of<Vector, vector>::value,
+                  "`Vector` must be a specialization of `state_space::vector`.");
+
+    template <class Key>
+    using element_type =
+        typename Vector::template element_type<Vector::template key_index<Key>::value>;
+
+  public:
+    using time_type = units::time::second_t;
+    using value_type = std::pair<time_type, Vector>;
+
+    explicit trajectory_reader(const std::string& path)
+    {
+        const auto fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) {
+            throw trajectory_file_error{"Unable to open `" + path + "` for reading."};
+        }
+
+        struct stat info {};
+        if (::fstat(fd, &info) != 0) {
+            ::close(fd);
+            throw trajectory_file_error{"Unable to read the size of `" + path + "`."};
+        }
+        size_ = static_cast<std::size_t>(info.st_size);
+
+        if (size_ > 0) {
+            auto mapping = ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (mapping == MAP_FAILED) {
+                ::close(fd);
+                throw trajectory_file_error{"Unable to map `" + path + "`."};
+            }
+            data_ = static_cast<const char*>(mapping);
+        }
+        ::close(fd);
+
+        try {
+            parse(path);
+        } catch (...) {
+            unmap();
+            throw;
+        }
+    }
+
+    trajectory_reader(trajectory_reader&& other) noexcept
+        : data_{std::exchange(other.data_, nullptr)},
+          size_{std::exchange(other.size_, 0)},
+          names_{std::move(other.names_)},
+          blocks_{other.blocks_},
+          block_size_{other.block_size_},
+          block_rows_{other.block_rows_},
+          rows_{other.rows_},
+          offsets_{other.offsets_}
+    {}
+
+    trajectory_reader(const trajectory_reader&) = delete;
+    auto operator=(const trajectory_reader&) -> trajectory_reader& = delete;
+    auto operator=(trajectory_reader&&) -> trajectory_reader& = delete;
+
+    ~trajectory_reader() { unmap(); }
+
+    /// Number of samples
+    auto size() const noexcept -> std::size_t { return rows_; }
+
+    /// Key names recorded in the file
+    auto key_names() const -> const std::vector<std::string>& { return names_; }
+
+    auto time() const -> column_view<time_type>
+    {
+        return {blocks_, offsets_[0], block_size_, block_rows_, rows_};
+    }
+
+    template <class Key>
+    auto column() const -> column_view<element_type<Key>>
+    {
+        return {blocks_,
+                offsets_[Vector::template key_index<Key>::value + 1],
+                block_size_,
+                block_rows_,
+                rows_};
+    }
+
+    /// Construct the sample at index `i`
+    auto operator[](std::size_t i) const -> value_type
+    {
+        return {time()[i], state(i, std::make_index_sequence<Vector::size>{})};
+    }
+
+  private:
+    template <std::size_t... Is>
+    auto state(std::size_t i, std::index_sequence<Is...>) const -> Vector
+    {
+        return {column_view<typename Vector::template element_type<Is>>{
+            blocks_, offsets_[Is + 1], block_size_, block_rows_, rows_}[i]...};
+    }
+
+    template <class T>
+    auto read(std::size_t& offset, const std::string& path) const -> T
+    {
+        if (offset + sizeof(T) > size_) {
+            throw trajectory_file_error{"`" + path + "` has a truncated header."};
+        }
+
+        auto value = T{};
+        std::memcpy(&value, data_ + offset, sizeof(T));
+        offset += sizeof(T);
+
+        return value;
+    }
+
+    auto parse(const std::string& path) -> void
+    {
+        namespace format = detail::trajectory_file;
+
+        auto offset = std::size_t{};
+
+        const auto magic = read<std::array<char, sizeof(format::magic)>>(offset, path);
+        if (std::memcmp(magic.data(), format::magic, sizeof(format::magic)) != 0) {
+            throw trajectory_file_error{"`" + path + "` is not a trajectory file."};
+        }
+        if (read<std::uint32_t>(offset, path) != format::byte_order_mark) {
+            throw trajectory_file_error{"`" + path + "` was written with a different byte order."};
+        }
+        if (read<std::uint32_t>(offset, path) != format::version) {
+            throw trajectory_file_error{"`" + path + "` has an unsupported version."};
+        }
+
+        block_rows_ = static_cast<std::size_t>(read<std::uint64_t>(offset, path));
+        if (block_rows_ == 0) {
+            throw trajectory_file_error{"`" + path + "` has zero rows per block."};
+        }
+
+        if (read<std::uint32_t>(offset, path) != Vector::size) {
+            throw trajectory_file_error{"`" + path + "` does not have " +
+                                        std::to_string(Vector::size) + " keys."};
+        }
+
+        const auto expected = format::describe_all<Vector>();
+        const auto expected_names = detail::key_names(typename format::keys_of<Vector>::type{});
+
+        offsets_[0] = sizeof(std::uint64_t);
+        block_size_ = offsets_[0] + format::pad(block_rows_ * sizeof(double));
+
+        for (auto i = std::size_t{}; i < Vector::size; ++i) {
+            const auto length = read<std::uint32_t>(offset, path);
+            if (offset + length > size_) {
+                throw trajectory_file_error{"`" + path + "` has a truncated header."};
+            }
+            names_.emplace_back(data_ + offset, length);
+            offset += length;
+
+            if (names_.back() != expected_names[i]) {
+                throw trajectory_file_error{
+                    "Key " + std::to_string(i) + " (`" + names_.back() + "`) of `" + path +
+                    "` does not match the requested key `" + expected_names[i] + "`."};
+            }
+
+            if (!(read<format::unit_descriptor>(offset, path) == expected[i])) {
+                throw trajectory_file_error{"Key " + std::to_string(i) + " (`" + names_.back() +
+                                            "`) of `" + path +
+                                            "` does not match the requested unit or type."};
+            }
+
+            offsets_[i + 1] = block_size_;
+            block_size_ += format::pad(block_rows_ * expected[i].value_size);
+        }
+
+        const auto header_size = format::pad(offset, format::alignment);
+        if (header_size > size_) {
+            throw trajectory_file_error{"`" + path + "` has a truncated header."};
+        }
+        blocks_ = data_ + header_size;
+
+        const auto data_size = size_ - header_size;
+        if (data_size % block_size_ != 0) {
+            throw trajectory_file_error{"`" + path + "` has a truncated block."};
+        }
+
+        const auto blocks = data_size / block_size_;
+        if (blocks > 0) {
+            auto last = header_size + (blocks - 1) * block_size_;
+            const auto rows = static_cast<std::size_t>(read<std::uint64_t>(last, path));
+
+            if ((rows == 0) || (rows > block_rows_)) {
+                throw trajectory_file_error{"`" + path + "` has an invalid block."};
+            }
+
+            rows_ = (blocks - 1) * block_rows_ + rows;
+        }
+    }
+
+    auto unmap() noexcept -> void
+    {
+        if (data_ != nullptr) {
+            ::munmap(const_cast<char*>(data_), size_);
+            data_ = nullptr;
+        }
+    }
+
+    const char* data_ = nullptr;
+    std::size_t size_ = 0;
+
+    std::vector<std::string> names_;
+    const char* blocks_ = nullptr;
+    std::size_t block_size_ = 0;
+    std::size_t block_rows_ = 0;
+    std::size_t rows_ = 0;
+
+    // Offset of the time column and each key column within a block
+    std::array<std::size_t, Vector::size + 1> offsets_ = {};
+};
+
+}  // namespace state_space
+}  // namespace ode
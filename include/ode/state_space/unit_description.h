@@ -0,0 +1,50 @@
+#pragma once
+
+#include "ode/tmp/type_traits.h"
+#include "units.h"
+
+#include <cstdint>
+#include <type_traits>
+
+namespace ode {
+namespace state_space {
+namespace detail {
+
+/// Kind of the underlying value of a unit container, as recorded by binary formats
+enum class value_kind : std::uint32_t { floating_point, signed_integer, unsigned_integer };
+
+template <class T>
+constexpr auto kind_of() -> value_kind
+{
+    return std::is_floating_point<T>::value
+               ? value_kind::floating_point
+               : (std::is_signed<T>::value ? value_kind::signed_integer
+                                           : value_kind::unsigned_integer);
+}
+
+template <class BaseUnit>
+struct base_unit_ratios;
+
+template <class... Ratios>
+struct base_unit_ratios<units::base_unit<Ratios...>> {
+    using type = tmp::list<Ratios...>;
+};
+
+/// @brief Ratios describing the unit of a unit container
+/// @note `dimension` holds the exponents of the SI base units and `scale` the conversion factor,
+/// pi exponent and translation of the unit.
+template <class UnitType>
+struct unit_ratios {
+  private:
+    using traits = units::traits::unit_traits<typename UnitType::unit_type>;
+
+  public:
+    using dimension = typename base_unit_ratios<typename traits::base_unit_type>::type;
+    using scale = tmp::list<typename traits::conversion_ratio,
+                            typename traits::pi_exponent_ratio,
+                            typename traits::translation_ratio>;
+};
+
+}  // namespace detail
+}  // namespace state_space
+}  // namespace ode
@@ -4,29 +4,333 @@
 #include "ode/tmp/type_traits.h"
 #include "units.h"
 
+#include <array>
+#include <cstddef>
 #include <iosfwd>
 #include <tuple>
+#include <type_traits>
+#include <utility>
 
 namespace ode {
 namespace state_space {
 
 namespace detail {
 
-template <class Scalar>
-struct elementwise_scalar_multiply {
-    static_assert(units::traits::is_dimensionless_unit<Scalar>::value,
-                  "`Scalar` must be a dimensionless unit.");
+using implicit_duration_type = units::time::second_t;
+
+/// Underlying type of a unit container, or the type itself otherwise
+template <class T, class = void>
+struct underlying {
+    using type = T;
+};
+
+template <class T>
+struct underlying<T, std::enable_if_t<units::traits::is_unit_t<T>::value>> {
+    using type = typename T::underlying_type;
+};
+
+template <class T>
+using underlying_t = typename underlying<T>::type;
+
+/// @brief Precision of the elements of a vector, their common underlying type
+/// @note Elements of a type other than a unit container of an arithmetic type count as `double`.
+template <class Vector, class = std::make_index_sequence<Vector::size>>
+struct real_type;
 
+template <class Vector, std::size_t... Is>
+struct real_type<Vector, std::index_sequence<Is...>> {
     template <class T>
-    constexpr auto operator()(T& elem)
+    using real = std::conditional_t<std::is_arithmetic<underlying_t<T>>::value,
+                                    underlying_t<T>,
+                                    double>;
+
+    using type = std::common_type_t<real<typename Vector::template element_type<Is>>...>;
+};
+
+template <class Vector>
+using real_t = typename real_type<Vector>::type;
+
+/// Seconds in the precision of a unit container, so that a `float` duration is not widened to
+/// `double`
+template <class Duration>
+using seconds_t = std::conditional_t<units::traits::is_unit_t<Duration>::value,
+                                     units::unit_t<units::time::seconds, underlying_t<Duration>>,
+                                     implicit_duration_type>;
+
+/// @brief Access to the elements of vectors and vector expressions by index
+/// @note Elements of a vector of unit containers with the same underlying type are additionally
+/// accessed as their underlying values, so that an expression is evaluated in the arithmetic of
+/// the underlying type without converting units.
+struct access {
+    template <std::size_t I, class Expr>
+    static constexpr decltype(auto) element(const Expr& e)
     {
-        elem *= scalar;
+        return e.template at<I>();
     }
 
-    const Scalar scalar;
+    template <std::size_t I, class Expr>
+    static constexpr auto underlying(const Expr& e)
+    {
+        return e.template underlying<I>();
+    }
 };
 
-using implicit_duration_type = units::time::second_t;
+/// Smallest power of two not less than `bytes`, between `alignment` and the alignment
+/// guaranteed by `operator new` so that vectors may be allocated dynamically
+constexpr auto storage_alignment(std::size_t bytes, std::size_t alignment) -> std::size_t
+{
+    while (alignment < bytes && alignment < alignof(std::max_align_t)) {
+        alignment *= 2;
+    }
+    return alignment;
+}
+
+/// @brief Checks if all values are unit containers with a linear scale and the same arithmetic
+/// underlying type
+template <class Values, class = void>
+struct is_homogeneous : std::false_type {};
+
+template <class T, class... Units>
+struct is_homogeneous<tmp::list<units::unit_t<Units, T, units::linear_scale>...>,
+                      std::enable_if_t<std::is_arithmetic<T>::value>> : std::true_type {};
+
+/// @brief Values stored in order as the members of nested structs
+/// @note Unlike `std::tuple`, the members are laid out in the order of the values, so values of
+/// the same size and alignment are contiguous. An aggregate, initialized from the values in order
+/// by brace elision.
+template <class... Values>
+struct packed;
+
+template <class Value>
+struct packed<Value> {
+    Value head;
+};
+
+template <class Value, class Next, class... Values>
+struct packed<Value, Next, Values...> {
+    Value head;
+    packed<Next, Values...> tail;
+};
+
+template <std::size_t I>
+struct packed_element {
+    template <class Packed>
+    static constexpr auto get(Packed& p) -> decltype(auto)
+    {
+        return packed_element<I - 1>::get(p.tail);
+    }
+};
+
+template <>
+struct packed_element<0> {
+    template <class Packed>
+    static constexpr auto get(Packed& p) -> decltype(auto)
+    {
+        return (p.head);
+    }
+};
+
+template <class Values, class = void>
+struct vector_storage;
+
+/// @brief Values of different types, stored as a tuple
+template <class... Values>
+struct vector_storage<tmp::list<Values...>,
+                      std::enable_if_t<!is_homogeneous<tmp::list<Values...>>::value>> {
+    using type = std::tuple<Values...>;
+
+    static constexpr std::size_t alignment = alignof(type);
+
+    template <class... Args>
+    static constexpr auto make(Args&&... args) -> type
+    {
+        return type{std::forward<Args>(args)...};
+    }
+
+    template <class Expr, std::size_t... Is>
+    static constexpr auto evaluate(const Expr& e, std::index_sequence<Is...>) -> type
+    {
+        return make(access::element<Is>(e)...);
+    }
+
+    template <std::size_t I>
+    static constexpr auto get(const type& d) -> const std::tuple_element_t<I, type>&
+    {
+        return std::get<I>(d);
+    }
+
+    template <std::size_t I>
+    static constexpr auto get(type& d) -> std::tuple_element_t<I, type>&
+    {
+        return std::get<I>(d);
+    }
+
+    template <std::size_t I, class Visitor, class... Ts>
+    static constexpr auto visit(type& d, Visitor& v, const Ts&... others) -> void
+    {
+        v(std::get<I>(d), others...);
+    }
+
+    template <std::size_t... Is>
+    static constexpr auto add_to(type& d, const type& other, std::index_sequence<Is...>) -> void
+    {
+        const auto unused = {(std::get<Is>(d) += std::get<Is>(other), 0)...};
+        (void)unused;
+    }
+
+    template <class Scalar, std::size_t... Is>
+    static constexpr auto scale(type& d, Scalar a, std::index_sequence<Is...>) -> void
+    {
+        const auto unused = {(std::get<Is>(d) *= a, 0)...};
+        (void)unused;
+    }
+};
+
+/// @brief Unit containers with the same underlying type, stored contiguously in order
+/// @note The storage has the layout of an array of the underlying values, so that its bytes may
+/// be copied as one block. Expressions are evaluated and compound assignment is applied in the
+/// arithmetic of the underlying type.
+template <class T, class... Units>
+struct vector_storage<tmp::list<units::unit_t<Units, T, units::linear_scale>...>,
+                      std::enable_if_t<std::is_arithmetic<T>::value>> {
+    using type = packed<units::unit_t<Units, T>...>;
+
+    static_assert(std::is_standard_layout<type>::value &&
+                      (sizeof(type) == sizeof(std::array<T, sizeof...(Units)>)),
+                  "A unit container must have the layout of its underlying type.");
+
+    static constexpr std::size_t alignment = storage_alignment(sizeof(type), alignof(type));
+
+    template <std::size_t I>
+    using value_type = tmp::at<I, tmp::list<units::unit_t<Units, T>...>>;
+
+    template <class... Args>
+    static constexpr auto make(Args&&... args) -> type
+    {
+        return type{units::unit_t<Units, T>{std::forward<Args>(args)}...};
+    }
+
+    template <class Expr, std::size_t... Is>
+    static constexpr auto evaluate(const Expr& e, std::index_sequence<Is...>) -> type
+    {
+        return type{value_type<Is>{static_cast<T>(access::underlying<Is>(e))}...};
+    }
+
+    template <std::size_t I>
+    static constexpr auto get(const type& d) -> const value_type<I>&
+    {
+        return packed_element<I>::get(d);
+    }
+
+    template <std::size_t I>
+    static constexpr auto get(type& d) -> value_type<I>&
+    {
+        return packed_element<I>::get(d);
+    }
+
+    template <std::size_t I, class Visitor, class... Ts>
+    static constexpr auto visit(type& d, Visitor& v, const Ts&... others) -> void
+    {
+        v(get<I>(d), others...);
+    }
+
+    template <std::size_t... Is>
+    static constexpr auto add_to(type& d, const type& other, std::index_sequence<Is...>) -> void
+    {
+        const auto unused = {(get<Is>(d) += get<Is>(other), 0)...};
+        (void)unused;
+    }
+
+    template <class Scalar, std::size_t... Is>
+    static constexpr auto scale(type& d, Scalar a, std::index_sequence<Is...>) -> void
+    {
+        const auto factor = static_cast<T>(a);
+
+        const auto unused = {(get<Is>(d) *= factor, 0)...};
+        (void)unused;
+    }
+};
+
+template <class Values, class Args, class = void>
+struct is_elementwise_constructible : std::false_type {};
+
+template <class... Values, class... Args>
+struct is_elementwise_constructible<tmp::list<Values...>,
+                                    tmp::list<Args...>,
+                                    std::enable_if_t<sizeof...(Values) == sizeof...(Args)>>
+    : tmp::all_of<std::is_constructible<Values, Args>...> {};
+
+}  // namespace detail
+
+/// @brief Describes a type that may be stored as an element of a `vector`
+/// @note Specialize for element types other than unit containers. A specialization derives from
+/// `std::true_type` and provides the unit of the element as `unit_type` and the element type with
+/// the same underlying representation and a different unit as `rebind<Unit>`.
+template <class T, class = void>
+struct value_traits : std::false_type {};
+
+template <class T>
+struct value_traits<T, std::enable_if_t<units::traits::is_unit_t<T>::value>> : std::true_type {
+    using unit_type = typename T::unit_type;
+
+    template <class Unit>
+    using rebind = units::unit_t<Unit, typename T::underlying_type>;
+};
+
+template <class, std::size_t>
+class batch;
+
+template <class...>
+class vector;
+
+namespace detail {
+
+/// @brief Base of the unevaluated vector expressions, each providing `result_type`, the vector it
+/// evaluates to
+/// @note Other types providing `result_type`, such as function objects, are not expressions.
+struct vector_expression {};
+
+template <class T>
+using is_expression = std::is_base_of<vector_expression, T>;
+
+/// @brief The vector a vector expression evaluates to
+template <class T, class = void>
+struct expression_result {};
+
+template <class... Args>
+struct expression_result<vector<Args...>> {
+    using type = vector<Args...>;
+};
+
+template <class T>
+struct expression_result<T, std::enable_if_t<is_expression<T>::value>> {
+    using type = typename T::result_type;
+};
+
+template <class T>
+using result_t = typename expression_result<std::decay_t<T>>::type;
+
+template <class T, class = void>
+struct is_vector_expression : std::false_type {};
+
+template <class T>
+struct is_vector_expression<T, tmp::void_t<result_t<T>>> : std::true_type {};
+
+/// @brief Checks if `T` is an unevaluated expression evaluating to `Vector`
+template <class T, class Vector, class = void>
+struct is_unevaluated : std::false_type {};
+
+template <class T, class Vector>
+struct is_unevaluated<T, Vector, std::enable_if_t<is_expression<T>::value>>
+    : std::is_same<typename T::result_type, Vector> {};
+
+/// Vectors bound to an lvalue are referenced by an expression while temporaries and
+/// subexpressions are stored by value, so an expression never outlives its operands
+template <class T>
+using operand_t = std::conditional_t<std::is_lvalue_reference<T>::value &&
+                                         tmp::is_specialization_of<std::decay_t<T>, vector>::value,
+                                     const std::decay_t<T>&,
+                                     std::decay_t<T>>;
 
 }  // namespace detail
 
@@ -42,19 +346,22 @@ class vector {
     template <class T>
     using enable_if_key = std::enable_if_t<key_index_mapping::template contains_key<T*>::value>;
 
+    template <class T>
+    using is_value = value_traits<T>;
+
+    using storage = detail::vector_storage<values>;
+
     template <bool InverseTime>
     using time_base =
         std::conditional_t<InverseTime, units::inverse<units::time::second>, units::time::second>;
 
-    template <class Unit, int DerivOrder>
+    template <class Value, int DerivOrder>
     struct unit_with_deriv {
-        using type = units::unit_t<
-            tmp::rebind_outer<
-                tmp::push_front<typename Unit::unit_type,
-                                tmp::repeat<tmp::abs(DerivOrder), time_base<(DerivOrder > 0)>>>,
-                tmp::list,
-                units::compound_unit>,
-            typename Unit::underlying_type>;
+        using type = typename value_traits<Value>::template rebind<tmp::rebind_outer<
+            tmp::push_front<typename value_traits<Value>::unit_type,
+                            tmp::repeat<tmp::abs(DerivOrder), time_base<(DerivOrder > 0)>>>,
+            tmp::list,
+            units::compound_unit>>;
     };
 
     template <class UnitDerivArgPair>
@@ -67,16 +374,25 @@ class vector {
     static_assert((sizeof...(Args) % 2) == 0,
                   "A vector requires an even number of template types.");
     static_assert((sizeof...(Args) > 0), "A vector requires more than zero template types.");
-    static_assert(!tmp::rebind_outer<tmp::map<std::is_pointer, keys>, tmp::disjunction>::value,
+    static_assert(!tmp::rebind_outer<tmp::map<std::is_pointer, keys>, tmp::any_of>::value,
                   "Vector key types cannot be pointers.");
-    static_assert(
-        tmp::rebind_outer<tmp::map<units::traits::is_unit_t, values>, tmp::conjunction>::value,
-        "Vector value types must be a unit container.");
+    static_assert(tmp::rebind_outer<tmp::map<is_value, values>, tmp::all_of>::value,
+                  "Vector value types must be a unit container or provide `value_traits`.");
 
-    using data_type = tmp::rebind_outer<values, std::tuple>;
+    /// Values stored contiguously in order if all values are unit containers with the same
+    /// underlying type, otherwise a tuple of the values
+    using data_type = typename storage::type;
 
     static constexpr std::size_t size = sizeof...(Args) / 2;
 
+    /// Type of the element at index `I`
+    template <std::size_t I>
+    using element_type = tmp::at<I, values>;
+
+    /// Index of the element associated with a key, in the order of the keys
+    template <class T, class = enable_if_key<T>>
+    using key_index = typename key_index_mapping::template at_key<T*>;
+
     template <int N = 1>
     using derivative = tmp::rebind_outer<
         tmp::interleave<
@@ -86,29 +402,52 @@ class vector {
         vector>;
 
     constexpr vector() = default;
+    constexpr vector(const vector&) = default;
+    constexpr vector(vector&&) = default;
 
     template <class... Utypes,
-              class = std::enable_if_t<std::is_constructible<data_type, Utypes...>::value>>
-    constexpr vector(Utypes&&... args) : data_{std::forward<Utypes>(args)...}
+              class = std::enable_if_t<
+                  detail::is_elementwise_constructible<values, tmp::list<Utypes...>>::value>>
+    constexpr vector(Utypes&&... args) : data_{storage::make(std::forward<Utypes>(args)...)}
+    {}
+
+    /// Evaluate a vector expression, computing each element in a single pass without
+    /// intermediate vectors
+    template <class Expr, class = std::enable_if_t<detail::is_unevaluated<Expr, vector>::value>>
+    constexpr vector(const Expr& e) : data_{storage::evaluate(e, std::make_index_sequence<size>{})}
     {}
 
+    /// @note `std::tuple` assignment is not `constexpr` until C++20 so elements are assigned
+    /// individually, allowing reassignment within constant expressions.
+    constexpr auto operator=(const vector& other) -> vector&
+    {
+        assign_impl(other, std::make_index_sequence<size>{});
+
+        return *this;
+    }
+
     template <class T, class = enable_if_key<T>>
     constexpr decltype(auto) get()
     {
-        using Index = typename key_index_mapping::template at_key<T*>;
-        return std::get<Index::value>(data_);
+        return storage::template get<key_index<T>::value>(data_);
     }
 
     template <class T, class = enable_if_key<T>>
     constexpr decltype(auto) get() const
     {
-        using Index = typename key_index_mapping::template at_key<T*>;
-        return std::get<Index::value>(data_);
+        return storage::template get<key_index<T>::value>(data_);
     }
 
+    /// @brief Underlying storage
+    /// @note If all values are unit containers with the same underlying type, the bytes of the
+    /// storage are the underlying values in order and may be copied with `memcpy`.
+    constexpr auto data() -> data_type& { return data_; }
+
+    constexpr auto data() const -> const data_type& { return data_; }
+
     constexpr auto operator+=(const vector& other) -> vector&
     {
-        add_to_impl(other, std::make_index_sequence<size>{});
+        storage::add_to(data_, other.data_, std::make_index_sequence<size>{});
 
         return *this;
     }
@@ -117,90 +456,270 @@ class vector {
     constexpr auto operator*=(Scalar a)
         -> std::enable_if_t<units::traits::is_dimensionless_unit<Scalar>::value, vector&>
     {
-        for_each(detail::elementwise_scalar_multiply<Scalar>{a});
+        storage::scale(data_, a, std::make_index_sequence<size>{});
 
         return *this;
     }
 
-    template <class Duration>
-    constexpr auto operator*(Duration dt) const
-        -> std::enable_if_t<std::is_convertible<Duration, detail::implicit_duration_type>::value,
-                            derivative<-1>>
-    {
-        return multiply_by_time_impl(dt, std::make_index_sequence<size>{});
-    }
-
     template <class Visitor>
     constexpr auto for_each(Visitor v) -> void
     {
-        for_each_impl(this, v, std::make_index_sequence<size>{});
+        for_each_impl(v, std::make_index_sequence<size>{}, *this);
     }
 
     template <class Visitor>
     constexpr auto for_each(Visitor v) const -> void
     {
-        for_each_impl(this, v, std::make_index_sequence<size>{});
+        for_each_impl(v, std::make_index_sequence<size>{}, *this);
+    }
+
+    /// Visit each element together with the elements at the same index of other vectors
+    template <class Visitor, class Vector, class... Vectors>
+    constexpr auto for_each(Visitor v, const Vector& other, const Vectors&... others) -> void
+    {
+        static_assert(tmp::conjunction<tmp::bool_constant<Vector::size == size>,
+                                       tmp::bool_constant<Vectors::size == size>...>::value,
+                      "Vectors must have the same size.");
+
+        for_each_impl(v, std::make_index_sequence<size>{}, *this, other, others...);
+    }
+
+    template <class Visitor, class Vector, class... Vectors>
+    constexpr auto for_each(Visitor v, const Vector& other, const Vectors&... others) const -> void
+    {
+        static_assert(tmp::conjunction<tmp::bool_constant<Vector::size == size>,
+                                       tmp::bool_constant<Vectors::size == size>...>::value,
+                      "Vectors must have the same size.");
+
+        for_each_impl(v, std::make_index_sequence<size>{}, *this, other, others...);
     }
 
   private:
-    template <class Self, class Visitor, std::size_t... Is>
-    static constexpr auto for_each_impl(Self self, Visitor v, std::index_sequence<Is...>) -> void
+    template <std::size_t I>
+    constexpr decltype(auto) at() const
     {
-        const auto unused = {(v(std::get<Is>(self->data_)), 0)...};
-        (void)unused;
+        return storage::template get<I>(data_);
     }
 
-    template <std::size_t... Is>
-    constexpr auto add_to_impl(const vector& other, std::index_sequence<Is...>) -> void
+    template <std::size_t I>
+    constexpr auto underlying() const
     {
-        const auto unused = {(std::get<Is>(data_) += std::get<Is>(other.data_), 0)...};
-        (void)unused;
+        return storage::template get<I>(data_).value();
     }
 
-    template <std::size_t... Is>
-    constexpr auto multiply_by_time_impl(detail::implicit_duration_type dt,
-                                         std::index_sequence<Is...>) const -> derivative<-1>
+    template <std::size_t I, class Visitor, class... Vectors>
+    constexpr auto visit_at(Visitor& v, const Vectors&... vs) -> void
+    {
+        storage::template visit<I>(data_, v, vs.template at<I>()...);
+    }
+
+    template <std::size_t I, class Visitor, class... Vectors>
+    constexpr auto visit_at(Visitor& v, const Vectors&... vs) const -> void
     {
-        auto integral = derivative<-1>{};
+        v(at<I>(), vs.template at<I>()...);
+    }
 
-        const auto unused = {(std::get<Is>(integral.data_) += std::get<Is>(data_) * dt, 0)...};
+    template <class Visitor, std::size_t... Is, class Self, class... Vectors>
+    static constexpr auto
+    for_each_impl(Visitor& v, std::index_sequence<Is...>, Self& self, const Vectors&... vs)
+        -> void
+    {
+        const auto unused = {(self.template visit_at<Is>(v, vs...), 0)...};
         (void)unused;
+    }
 
-        return integral;
+    template <std::size_t... Is>
+    constexpr auto assign_impl(const vector& other, std::index_sequence<Is...>) -> void
+    {
+        const auto unused = {(storage::template get<Is>(data_) =
+                                  storage::template get<Is>(other.data_),
+                              0)...};
+        (void)unused;
     }
 
-    data_type data_;
+    alignas(storage::alignment) data_type data_ = {};
 
     template <class...>
     friend class vector;
+
+    template <class, std::size_t>
+    friend class batch;
+
+    friend struct detail::access;
 };
 
-template <class Vector>
-constexpr auto operator+(const Vector& x, const Vector& y)
-    -> std::enable_if_t<tmp::is_specialization_of<Vector, vector>::value, Vector>
+namespace detail {
+
+/// @brief Converts a factor to the precision in which it multiplies the elements of a vector
+/// @note Unit containers of an arithmetic type are multiplied in the wider of their own precision
+/// and that of the factor. A vector of `float` is multiplied in `float` by `float` factors and in
+/// `double` by `double` factors, in which case an expression is rounded to `float` once, when it
+/// is evaluated into a vector.
+template <class Element, class = void>
+struct precision {
+    template <class Factor>
+    static constexpr auto convert(Factor a) -> Factor
+    {
+        return a;
+    }
+};
+
+template <class Units, class T>
+struct precision<units::unit_t<Units, T, units::linear_scale>,
+                 std::enable_if_t<std::is_arithmetic<T>::value>> {
+    template <class Factor>
+    using type = std::common_type_t<T, underlying_t<Factor>>;
+
+    template <class R>
+    static constexpr auto convert(units::unit_t<units::time::seconds, R> dt)
+        -> units::unit_t<units::time::seconds, type<R>>
+    {
+        return dt;
+    }
+
+    template <class Scalar>
+    static constexpr auto convert(Scalar a) -> type<Scalar>
+    {
+        return static_cast<type<Scalar>>(a);
+    }
+};
+
+template <class Element, class Factor>
+constexpr auto multiply(const Element& e, Factor a)
 {
-    auto z = x;
-    return z += y;
+    return e * precision<Element>::convert(a);
 }
 
-template <class Scalar, class Vector>
-constexpr auto operator*(Scalar a, const Vector& x)
-    -> std::enable_if_t<tmp::is_specialization_of<Vector, vector>::value &&
+/// @brief Elementwise sum of two vector expressions evaluating to the same vector
+template <class Lhs, class Rhs>
+class sum : vector_expression {
+  public:
+    using result_type = result_t<Lhs>;
+
+    template <class L, class R>
+    constexpr sum(L&& lhs, R&& rhs) : lhs_{std::forward<L>(lhs)}, rhs_{std::forward<R>(rhs)}
+    {}
+
+    template <std::size_t I>
+    constexpr auto at() const
+    {
+        return access::element<I>(lhs_) + access::element<I>(rhs_);
+    }
+
+    template <std::size_t I>
+    constexpr auto underlying() const
+    {
+        return access::underlying<I>(lhs_) + access::underlying<I>(rhs_);
+    }
+
+  private:
+    Lhs lhs_;
+    Rhs rhs_;
+};
+
+/// @brief Product of a dimensionless scalar and a vector expression
+template <class Scalar, class Expr>
+class scaled : vector_expression {
+  public:
+    using result_type = result_t<Expr>;
+
+    template <class E>
+    constexpr scaled(Scalar a, E&& e) : a_{a}, e_{std::forward<E>(e)}
+    {}
+
+    template <std::size_t I>
+    constexpr auto at() const
+    {
+        return multiply(access::element<I>(e_), a_);
+    }
+
+    template <std::size_t I>
+    constexpr auto underlying() const
+    {
+        using type = std::common_type_t<decltype(access::underlying<I>(e_)), underlying_t<Scalar>>;
+
+        return static_cast<type>(access::underlying<I>(e_)) * static_cast<type>(a_);
+    }
+
+  private:
+    Scalar a_;
+    Expr e_;
+};
+
+/// @brief Product of a duration and a vector expression, evaluating to its integral
+/// @tparam Duration seconds in the precision of the duration
+template <class Duration, class Expr>
+class integral : vector_expression {
+  public:
+    using result_type = typename result_t<Expr>::template derivative<-1>;
+
+    template <class E>
+    constexpr integral(Duration dt, E&& e) : dt_{dt}, e_{std::forward<E>(e)}
+    {}
+
+    template <std::size_t I>
+    constexpr auto at() const
+    {
+        return multiply(access::element<I>(e_), dt_);
+    }
+
+    // Elements of an integral have the unit of the corresponding element multiplied by seconds
+    template <std::size_t I>
+    constexpr auto underlying() const
+    {
+        using type = std::common_type_t<decltype(access::underlying<I>(e_)),
+                                        typename Duration::underlying_type>;
+
+        return static_cast<type>(access::underlying<I>(e_)) * static_cast<type>(dt_.value());
+    }
+
+  private:
+    Duration dt_;
+    Expr e_;
+};
+
+template <class T>
+using is_duration = tmp::bool_constant<!units::traits::is_dimensionless_unit<T>::value &&
+                                       std::is_convertible<T, implicit_duration_type>::value>;
+
+}  // namespace detail
+
+/// @note Arithmetic on vectors returns an expression that is evaluated when converted to a
+/// vector, typically on assignment or when passed as an argument. An expression stored with
+/// `auto` is evaluated each time it is converted.
+template <class Lhs, class Rhs>
+constexpr auto operator+(Lhs&& lhs, Rhs&& rhs)
+    -> std::enable_if_t<std::is_same<detail::result_t<Lhs>, detail::result_t<Rhs>>::value,
+                        detail::sum<detail::operand_t<Lhs>, detail::operand_t<Rhs>>>
+{
+    return {std::forward<Lhs>(lhs), std::forward<Rhs>(rhs)};
+}
+
+template <class Scalar, class Expr>
+constexpr auto operator*(Scalar a, Expr&& e)
+    -> std::enable_if_t<detail::is_vector_expression<Expr>::value &&
                             units::traits::is_dimensionless_unit<Scalar>::value,
-                        Vector>
+                        detail::scaled<Scalar, detail::operand_t<Expr>>>
+{
+    return {a, std::forward<Expr>(e)};
+}
+
+template <class Duration, class Expr>
+constexpr auto operator*(Duration dt, Expr&& e)
+    -> std::enable_if_t<detail::is_vector_expression<Expr>::value &&
+                            detail::is_duration<Duration>::value,
+                        detail::integral<detail::seconds_t<Duration>, detail::operand_t<Expr>>>
 {
-    auto y = x;
-    return y *= a;
+    return {dt, std::forward<Expr>(e)};
 }
 
-template <class Duration, class Vector>
-constexpr auto operator*(Duration t, const Vector& x)
-    -> std::enable_if_t<tmp::is_specialization_of<Vector, vector>::value &&
-                            !units::traits::is_dimensionless_unit<Duration>::value &&
-                            std::is_convertible<Duration, detail::implicit_duration_type>::value,
-                        typename Vector::template derivative<-1>>
+template <class Expr, class Duration>
+constexpr auto operator*(Expr&& e, Duration dt)
+    -> std::enable_if_t<detail::is_vector_expression<Expr>::value &&
+                            detail::is_duration<Duration>::value,
+                        detail::integral<detail::seconds_t<Duration>, detail::operand_t<Expr>>>
 {
-    return x * t;
+    return {dt, std::forward<Expr>(e)};
 }
 
 template <class Vector>
@@ -0,0 +1,396 @@
+#pragma once
+
+#include "ode/state_space/key_name.h"
+#include "ode/state_space/unit_description.h"
+#include "ode/state_space/vector.h"
+#include "ode/tmp/type_traits.h"
+#include "units.h"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+namespace ode {
+namespace state_space {
+
+/// @brief Error reading a wire message
+class wire_format_error : public std::runtime_error {
+  public:
+    using std::runtime_error::runtime_error;
+};
+
+/// @brief Describes the values of a type sent as a wire message
+/// @note A specialization provides `value_types`, a `tmp::list` of the unit container of each
+/// value in order, a `constexpr` `key_names()`, returning a `std::array` of the name of each value
+/// in order, and `get<I>(x)`, returning a reference to value `I` of `x`. If `is_contiguous` is
+/// true, the values are stored in order without padding from `data(x)` and
+/// are copied with a single `memcpy`.
+template <class T, class = void>
+struct wire_traits;
+
+template <class... Args>
+struct wire_traits<vector<Args...>> {
+  private:
+    using type = vector<Args...>;
+
+    template <std::size_t I>
+    using key = tmp::at<2 * I, tmp::list<Args...>>;
+
+    using keys = tmp::skip<1, tmp::list<Args...>>;
+
+    template <std::size_t... Is>
+    static auto value_types_of(std::index_sequence<Is...>)
+        -> tmp::list<typename type::template element_type<Is>...>;
+
+  public:
+    using value_types = decltype(value_types_of(std::make_index_sequence<type::size>{}));
+
+    static constexpr bool is_contiguous = detail::is_homogeneous<value_types>::value;
+
+    /// @note Each key requires a `key_name`.
+    static constexpr auto key_names() -> std::array<const char*, type::size>
+    {
+        return detail::static_key_names(keys{});
+    }
+
+    template <std::size_t I>
+    static auto get(const type& x) -> decltype(auto)
+    {
+        return x.template get<key<I>>();
+    }
+
+    template <std::size_t I>
+    static auto get(type& x) -> decltype(auto)
+    {
+        return x.template get<key<I>>();
+    }
+
+    static auto data(const type& x) -> const void* { return &x.data(); }
+
+    static auto data(type& x) -> void* { return &x.data(); }
+};
+
+namespace detail {
+namespace wire_format {
+
+// Message layout, in native byte order:
+//
+// header
+//   magic                uint32
+//   version              uint16
+//   byte order mark      uint16
+//   fingerprint          uint64
+//   keys                 uint64
+// payload
+//   values               each underlying_type in order, aligned to its size
+//
+// The fingerprint is a hash of the version and of the size, kind, dimension and scale of each
+// value. Keys is a hash of the name of each value, so that reordering keys of the same unit is
+// detected.
+
+constexpr std::uint32_t magic = 0x5745444f;  // "ODEW"
+constexpr std::uint16_t version = 2;
+constexpr std::uint16_t byte_order_mark = 0x0102;
+
+constexpr auto align(std::size_t n, std::size_t to) -> std::size_t
+{
+    return (n + to - 1) / to * to;
+}
+
+/// Appends the bytes of `v` to an FNV-1a hash
+constexpr auto hash(std::uint64_t h, std::uint64_t v) -> std::uint64_t
+{
+    for (auto i = 0; i < 8; ++i) {
+        h ^= (v >> (8 * i)) & 0xff;
+        h *= 1099511628211ull;
+    }
+    return h;
+}
+
+/// Hash of the number of names and the length and characters of each name
+template <std::size_t N>
+constexpr auto hash_names(const std::array<const char*, N>& names) -> std::uint64_t
+{
+    auto h = hash(14695981039346656037ull, N);
+
+    for (auto i = std::size_t{}; i < N; ++i) {
+        auto length = std::size_t{};
+        while (names[i][length] != '\0') {
+            ++length;
+        }
+
+        h = hash(h, length);
+        for (auto j = std::size_t{}; j < length; ++j) {
+            h ^= static_cast<unsigned char>(names[i][j]);
+            h *= 1099511628211ull;
+        }
+    }
+    return h;
+}
+
+template <class... Ratios>
+constexpr auto hash_ratios(std::uint64_t h, tmp::list<Ratios...>) -> std::uint64_t
+{
+    const auto unused = {(h = hash(hash(h, static_cast<std::uint64_t>(Ratios::num)),
+                                   static_cast<std::uint64_t>(Ratios::den)),
+                          0)...};
+    (void)unused;
+
+    return h;
+}
+
+template <class UnitType>
+constexpr auto hash_unit(std::uint64_t h) -> std::uint64_t
+{
+    using underlying_type = typename UnitType::underlying_type;
+    using ratios = unit_ratios<UnitType>;
+
+    h = hash(h, sizeof(underlying_type));
+    h = hash(h, static_cast<std::uint64_t>(kind_of<underlying_type>()));
+    h = hash_ratios(h, typename ratios::dimension{});
+    return hash_ratios(h, typename ratios::scale{});
+}
+
+template <class UnitType>
+using has_underlying_size =
+    tmp::bool_constant<sizeof(UnitType) == sizeof(typename UnitType::underlying_type)>;
+
+template <class ValueTypes>
+struct layout;
+
+template <class... Values>
+struct layout<tmp::list<Values...>> {
+    static_assert(sizeof...(Values) > 0, "A wire message requires at least one value.");
+    static_assert(tmp::all_of<std::is_arithmetic<typename Values::underlying_type>...>::value,
+                  "Wire messages require arithmetic underlying types.");
+    static_assert(tmp::all_of<has_underlying_size<Values>...>::value,
+                  "A unit container must have the size of its underlying type.");
+
+    static constexpr std::size_t count = sizeof...(Values);
+
+    static constexpr auto offset(std::size_t i) -> std::size_t
+    {
+        const std::size_t sizes[] = {sizeof(Values)...};
+
+        auto n = std::size_t{};
+        for (auto j = std::size_t{}; j < i; ++j) {
+            n = align(n, sizes[j]) + sizes[j];
+        }
+        return align(n, sizes[i]);
+    }
+
+    static constexpr auto size() -> std::size_t
+    {
+        return offset(count - 1) + sizeof(tmp::at<count - 1, tmp::list<Values...>>);
+    }
+
+    static constexpr auto fingerprint() -> std::uint64_t
+    {
+        auto h = hash(hash(14695981039346656037ull, version), count);
+
+        const auto unused = {(h = hash_unit<Values>(h), 0)...};
+        (void)unused;
+
+        return h;
+    }
+};
+
+template <class T>
+using layout_of = layout<typename wire_traits<T>::value_types>;
+
+template <class T, std::size_t... Is>
+auto write(const T& x, unsigned char* payload, std::false_type, std::index_sequence<Is...>)
+    -> void
+{
+    const auto unused = {(std::memcpy(payload + layout_of<T>::offset(Is),
+                                      &wire_traits<T>::template get<Is>(x),
+                                      sizeof(wire_traits<T>::template get<Is>(x))),
+                          0)...};
+    (void)unused;
+}
+
+template <class T, class Indices>
+auto write(const T& x, unsigned char* payload, std::true_type, Indices) -> void
+{
+    std::memcpy(payload, wire_traits<T>::data(x), layout_of<T>::size());
+}
+
+template <class T, std::size_t... Is>
+auto read(T& x, const unsigned char* payload, std::false_type, std::index_sequence<Is...>)
+    -> void
+{
+    const auto unused = {(std::memcpy(&wire_traits<T>::template get<Is>(x),
+                                      payload + layout_of<T>::offset(Is),
+                                      sizeof(wire_traits<T>::template get<Is>(x))),
+                          0)...};
+    (void)unused;
+}
+
+template <class T, class Indices>
+auto read(T& x, const unsigned char* payload, std::true_type, Indices) -> void
+{
+    std::memcpy(wire_traits<T>::data(x), payload, layout_of<T>::size());
+}
+
+template <class T>
+using contiguous = tmp::bool_constant<wire_traits<T>::is_contiguous>;
+
+template <class T>
+using value_indices = std::make_index_sequence<layout_of<T>::count>;
+
+}  // namespace wire_format
+}  // namespace detail
+
+/// Header identifying the layout of a wire message
+struct wire_header {
+    std::uint32_t magic;
+    std::uint16_t version;
+    std::uint16_t byte_order;
+    std::uint64_t fingerprint;
+    std::uint64_t keys;
+};
+
+/// @brief Fixed, trivially copyable binary layout of the values of `T`
+/// @tparam T type with `wire_traits`, such as a `state_space::vector`
+/// @note A message may be copied as raw bytes to, or read in place from, shared memory or a
+/// socket. Its payload is only read as `T` once its header matches the fingerprint of the units
+/// of `T` and the names of its keys.
+template <class T>
+struct wire_message {
+    using value_type = T;
+
+  private:
+    using layout = detail::wire_format::layout_of<T>;
+
+  public:
+    static constexpr std::uint64_t fingerprint = layout::fingerprint();
+    static constexpr std::size_t payload_size = layout::size();
+
+    /// Hash of the key names of `T`
+    static constexpr std::uint64_t keys =
+        detail::wire_format::hash_names(wire_traits<T>::key_names());
+
+    static auto expected_header() -> wire_header
+    {
+        return {detail::wire_format::magic,
+                detail::wire_format::version,
+                detail::wire_format::byte_order_mark,
+                fingerprint,
+                keys};
+    }
+
+    /// True if the header identifies the layout of `T`
+    auto valid() const -> bool { return matches(header); }
+
+    static auto matches(const wire_header& h) -> bool
+    {
+        return (h.magic == detail::wire_format::magic) &&
+               (h.version == detail::wire_format::version) &&
+               (h.byte_order == detail::wire_format::byte_order_mark) &&
+               (h.fingerprint == fingerprint) && (h.keys == keys);
+    }
+
+    /// Value at index `I`, read without reading the other values
+    template <std::size_t I>
+    auto get() const -> tmp::at<I, typename wire_traits<T>::value_types>
+    {
+        auto v = tmp::at<I, typename wire_traits<T>::value_types>{};
+        std::memcpy(&v, payload + layout::offset(I), sizeof(v));
+        return v;
+    }
+
+    auto value() const -> T
+    {
+        auto x = T{};
+        detail::wire_format::read(x,
+                                  payload,
+                                  detail::wire_format::contiguous<T>{},
+                                  detail::wire_format::value_indices<T>{});
+        return x;
+    }
+
+    wire_header header;
+    alignas(8) unsigned char payload[payload_size];
+};
+
+template <class T>
+constexpr std::uint64_t wire_message<T>::fingerprint;
+
+template <class T>
+constexpr std::size_t wire_message<T>::payload_size;
+
+template <class T>
+constexpr std::uint64_t wire_message<T>::keys;
+
+/// Writes `x` to a message, which may be in shared memory
+template <class T>
+auto serialize(const T& x, wire_message<T>& message) -> void
+{
+    message.header = wire_message<T>::expected_header();
+    detail::wire_format::write(x,
+                               message.payload,
+                               detail::wire_format::contiguous<T>{},
+                               detail::wire_format::value_indices<T>{});
+}
+
+template <class T>
+auto serialize(const T& x) -> wire_message<T>
+{
+    auto message = wire_message<T>{};
+    serialize(x, message);
+    return message;
+}
+
+/// @brief Refers to a message of `T` in place in `size` bytes, without copying
+/// @throws wire_format_error if the bytes are too few or misaligned for a message or hold a
+/// message of another type
+template <class T>
+auto wire_cast(const void* data, std::size_t size) -> const wire_message<T>&
+{
+    if (size < sizeof(wire_message<T>)) {
+        throw wire_format_error{"Too few bytes for a wire message."};
+    }
+
+    if ((reinterpret_cast<std::uintptr_t>(data) % alignof(wire_message<T>)) != 0) {
+        throw wire_format_error{"Wire message is misaligned."};
+    }
+
+    const auto& message = *static_cast<const wire_message<T>*>(data);
+    if (!message.valid()) {
+        throw wire_format_error{"Wire message does not match the layout of the value type."};
+    }
+
+    return message;
+}
+
+/// @brief Reads a value of `T` from a message in `size` bytes with any alignment
+/// @throws wire_format_error if the bytes are too few or hold a message of another type
+template <class T>
+auto deserialize(const void* data, std::size_t size) -> T
+{
+    if (size < sizeof(wire_message<T>)) {
+        throw wire_format_error{"Too few bytes for a wire message."};
+    }
+
+    const auto bytes = static_cast<const unsigned char*>(data);
+
+    auto header = wire_header{};
+    std::memcpy(&header, bytes, sizeof(header));
+    if (!wire_message<T>::matches(header)) {
+        throw wire_format_error{"Wire message does not match the layout of the value type."};
+    }
+
+    auto x = T{};
+    detail::wire_format::read(x,
+                              bytes + offsetof(wire_message<T>, payload),
+                              detail::wire_format::contiguous<T>{},
+                              detail::wire_format::value_indices<T>{});
+    return x;
+}
+
+}  // namespace state_space
+}  // namespace ode
@@ -1,10 +1,142 @@
 #pragma once
 
+#include "ode/lu_decomposition.h"
 #include "ode/tmp/type_traits.h"
 
+#include <array>
+#include <cstddef>
+#include <limits>
+#include <ratio>
+#include <stdexcept>
+#include <utility>
+
+// Categories of odeint steppers, declared so that steppers are classified without including odeint
+namespace boost {
+namespace numeric {
+namespace odeint {
+
+struct controlled_stepper_tag;
+struct explicit_controlled_stepper_tag;
+struct explicit_controlled_stepper_fsal_tag;
+struct dense_output_stepper_tag;
+
+}  // namespace odeint
+}  // namespace numeric
+}  // namespace boost
+
 namespace ode {
 namespace stepper {
 
+namespace detail {
+
+/// @brief Natural logarithm usable in constant expressions
+/// @note Intended for step size control where only a few digits of accuracy are required.
+constexpr auto log(double x) noexcept -> double
+{
+    constexpr auto ln2 = 0.693147180559945309417;
+    constexpr auto inf = std::numeric_limits<double>::infinity();
+
+    if (!(x > 0.0)) {
+        return (x == 0.0) ? -inf : std::numeric_limits<double>::quiet_NaN();
+    }
+    if (x == inf) {
+        return inf;
+    }
+
+    // x = m * 2^e with m in [1, 2)
+    auto e = 0;
+    while (x >= 2.0) {
+        x /= 2.0;
+        ++e;
+    }
+    while (x < 1.0) {
+        x *= 2.0;
+        --e;
+    }
+
+    // ln(m) = 2 * atanh((m - 1) / (m + 1))
+    const auto z = (x - 1.0) / (x + 1.0);
+    const auto z2 = z * z;
+
+    auto term = z;
+    auto sum = 0.0;
+    for (auto n = 1; n < 40; n += 2) {
+        sum += term / n;
+        term *= z2;
+    }
+
+    return 2.0 * sum + e * ln2;
+}
+
+/// @brief Exponential function usable in constant expressions
+constexpr auto exp(double x) noexcept -> double
+{
+    constexpr auto ln2 = 0.693147180559945309417;
+
+    // bounds of the arguments for which the result is finite and not zero
+    if (x != x) {
+        return x;
+    }
+    if (x > 709.8) {
+        return std::numeric_limits<double>::infinity();
+    }
+    if (x < -745.2) {
+        return 0.0;
+    }
+
+    // x = n * ln(2) + r with |r| <= ln(2) / 2
+    const auto n = static_cast<int>(x / ln2 + (x < 0.0 ? -0.5 : 0.5));
+    const auto r = x - n * ln2;
+
+    auto term = 1.0;
+    auto sum = 1.0;
+    for (auto k = 1; k < 20; ++k) {
+        term *= r / k;
+        sum += term;
+    }
+
+    for (auto k = 0; k < n; ++k) {
+        sum *= 2.0;
+    }
+    for (auto k = 0; k > n; --k) {
+        sum /= 2.0;
+    }
+
+    return sum;
+}
+
+/// @brief Power function for positive bases usable in constant expressions
+constexpr auto pow(double base, double exponent) noexcept -> double
+{
+    return exp(exponent * log(base));
+}
+
+template <class T>
+constexpr auto abs(T x) -> T
+{
+    return (x < T{0}) ? -x : x;
+}
+
+template <class T>
+constexpr auto min(T x, T y) -> T
+{
+    return (y < x) ? y : x;
+}
+
+template <class T>
+constexpr auto max(T x, T y) -> T
+{
+    return (x < y) ? y : x;
+}
+
+}  // namespace detail
+
+/// @brief Error integrating a step, such as an adaptive step size that can no longer be reduced
+class step_error : public std::runtime_error {
+  public:
+    using std::runtime_error::runtime_error;
+};
+
 template <class Function, class Time, class State, class = void>
 struct is_function : std::false_type {};
 
@@ -22,12 +154,114 @@ template <class T>
 struct is_state_space_stepper<T, tmp::void_t<tmp::bool_constant<T::is_state_space_stepper>>>
     : tmp::bool_constant<T::is_state_space_stepper> {};
 
+template <class Function, class Time, class State, class = void>
+struct has_jacobian : std::false_type {};
+
+template <class Function, class Time, class State>
+struct has_jacobian<Function,
+                    Time,
+                    State,
+                    tmp::void_t<decltype(std::declval<Function>().jacobian(
+                        std::declval<Time>(), std::declval<const State&>()))>> : std::true_type {};
+
+/// @brief Checks if a state space stepper requires the Jacobian of the system
+template <class, class = void>
+struct is_implicit_stepper : std::false_type {};
+
+template <class T>
+struct is_implicit_stepper<T, tmp::void_t<tmp::bool_constant<T::requires_jacobian>>>
+    : tmp::bool_constant<T::requires_jacobian && is_state_space_stepper<T>::value> {};
+
+/// @brief Checks if a state space stepper takes several internal steps per step, selecting their
+/// size to meet error tolerances
+template <class, class = void>
+struct is_adaptive_stepper : std::false_type {};
+
+template <class T>
+struct is_adaptive_stepper<T, tmp::void_t<tmp::bool_constant<T::is_adaptive>>>
+    : tmp::bool_constant<T::is_adaptive && is_state_space_stepper<T>::value> {};
+
 struct odeint_tag {};
+struct odeint_controlled_tag : odeint_tag {};
+struct odeint_dense_output_tag : odeint_tag {};
 struct state_space_tag {};
+struct implicit_tag : state_space_tag {};
+
+/// @brief Classifies an odeint stepper by its `stepper_category` as a stepper, a controlled
+/// stepper or a dense output stepper
+template <class T, class = void>
+struct odeint_category {
+    using type = odeint_tag;
+};
+
+template <class T>
+struct odeint_category<T, tmp::void_t<typename T::stepper_category>> {
+  private:
+    template <class Category>
+    using is = std::is_same<typename T::stepper_category, Category>;
+
+  public:
+    using type = std::conditional_t<
+        is<boost::numeric::odeint::controlled_stepper_tag>::value ||
+            is<boost::numeric::odeint::explicit_controlled_stepper_tag>::value ||
+            is<boost::numeric::odeint::explicit_controlled_stepper_fsal_tag>::value,
+        odeint_controlled_tag,
+        std::conditional_t<is<boost::numeric::odeint::dense_output_stepper_tag>::value,
+                           odeint_dense_output_tag,
+                           odeint_tag>>;
+};
+
+template <class T>
+using stepper_tag = std::conditional_t<
+    is_implicit_stepper<T>::value,
+    implicit_tag,
+    std::conditional_t<is_state_space_stepper<T>::value,
+                       state_space_tag,
+                       typename odeint_category<T>::type>>;
+
+template <class, class = void>
+struct is_dense_output_stepper : std::false_type {};
 
 template <class T>
-using stepper_tag =
-    std::conditional_t<is_state_space_stepper<T>::value, state_space_tag, odeint_tag>;
+struct is_dense_output_stepper<T, tmp::void_t<typename T::dense_output_type>>
+    : is_state_space_stepper<T> {};
+
+/// @brief Cubic Hermite interpolant of a solution over a single step
+/// @note The interpolant is third order accurate and matches the state and derivative at both
+/// ends of the step, so consecutive interpolants form a continuously differentiable solution.
+template <class State, class Scalar, class Deriv, class StepDuration>
+struct hermite_interpolant {
+    using state_type = State;
+    using scalar_type = Scalar;
+    using deriv_type = Deriv;
+    using step_type = StepDuration;
+    using timepoint_type = StepDuration;
+
+    /// Evaluate the solution at a time within [t0, t0 + dt]
+    constexpr auto operator()(timepoint_type t) const -> state_type
+    {
+        constexpr auto one = scalar_type{1};
+        constexpr auto two = scalar_type{2};
+        constexpr auto three = scalar_type{3};
+
+        const auto s = scalar_type{(t - t0) / dt};
+        const auto s2 = s * s;
+
+        const auto h00 = one + s2 * (two * s - three);
+        const auto h01 = s2 * (three - two * s);
+        const auto h10 = s * (s - one) * (s - one);
+        const auto h11 = s2 * (s - one);
+
+        return h00 * x0 + h01 * x1 + dt * (h10 * dxdt0 + h11 * dxdt1);
+    }
+
+    timepoint_type t0;
+    step_type dt;
+    state_type x0;
+    state_type x1;
+    deriv_type dxdt0;
+    deriv_type dxdt1;
+};
 
 template <class State, class Scalar, class Deriv, class StepDuration, class Unused = void>
 struct runge_kutta4 {
@@ -37,24 +271,764 @@ struct runge_kutta4 {
     using step_type = StepDuration;
     using timepoint_type = StepDuration;
 
+    using dense_output_type = hermite_interpolant<state_type, scalar_type, deriv_type, step_type>;
+
     static constexpr bool is_state_space_stepper = true;
 
     template <class Function>
     static constexpr auto step(Function f, const state_type& x, timepoint_type t, step_type dt)
         -> std::enable_if_t<is_function<Function, timepoint_type, state_type>::value, state_type>
+    {
+        return advance(f, x, f(t, x), t, dt);
+    }
+
+    /// Integrate over `dt` given the derivative at `x`, returning an interpolant of the step
+    /// @note The derivative at the end of the step is evaluated in place of the first stage of the
+    /// next step so dense output requires no additional function evaluations.
+    template <class Function>
+    static constexpr auto dense_step(
+        Function f, const state_type& x, const deriv_type& dxdt, timepoint_type t, step_type dt)
+        -> std::enable_if_t<is_function<Function, timepoint_type, state_type>::value,
+                            dense_output_type>
+    {
+        const auto x1 = advance(f, x, dxdt, t, dt);
+
+        return {t, dt, x, x1, dxdt, f(t + dt, x1)};
+    }
+
+  private:
+    template <class Function>
+    static constexpr auto advance(
+        Function f, const state_type& x, const deriv_type& k1, timepoint_type t, step_type dt)
+        -> state_type
     {
         // https://en.wikipedia.org/wiki/Runge%E2%80%93Kutta_methods
 
         const auto half_dt = dt / scalar_type{2};
 
-        const auto k1 = f(t, x);
-        const auto k2 = f(t + half_dt, x + half_dt * k1);
-        const auto k3 = f(t + half_dt, x + half_dt * k2);
-        const auto k4 = f(t + dt, x + dt * k3);
+        const auto k2 = f(t + half_dt, state_type{x + half_dt * k1});
+        const auto k3 = f(t + half_dt, state_type{x + half_dt * k2});
+        const auto k4 = f(t + dt, state_type{x + dt * k3});
 
         return x + dt / scalar_type{6} * (k1 + scalar_type{2} * (k2 + k3) + k4);
     }
 };
 
+/// @brief Embedded Runge-Kutta stepper of order 5(4) with adaptive step size control
+/// Dormand 1980 A family of embedded Runge-Kutta formulae
+/// @note A call to `step` integrates over `dt` with as many internal steps as required to meet
+/// the error tolerances. The last stage of an accepted internal step is reused as the first stage
+/// of the next (FSAL) and the internal step size is selected with a PI controller.
+/// @note An instance keeps the last stage, the proposed step size and the controller history of
+/// its last call to `step`. A call continuing from the state and time at which the last call
+/// ended, as made by `owning_step_iterator`, reuses them, so each accepted internal step costs six
+/// evaluations of `f` and internal steps may span several calls. Any other call starts afresh
+/// with an internal step of `dt`.
+/// @note Throws `step_error` if the error estimate is rejected `max_rejections` times in a row or
+/// the internal step size becomes too small to advance time, for example if `f` returns a
+/// non-finite derivative.
+/// @note Absolute tolerances are given per key, in the unit of each key. Relative tolerances are
+/// given per key, in the order of the keys.
+/// @note Dense output is not provided. A cubic interpolant over `dt` spanning several internal
+/// steps would have an error far above the tolerances, so `integrate_dense` rejects this stepper.
+template <class State, class Scalar, class Deriv, class StepDuration, class Unused = void>
+struct dormand_prince5 {
+    using state_type = State;
+    using scalar_type = Scalar;
+    using deriv_type = Deriv;
+    using step_type = StepDuration;
+    using timepoint_type = StepDuration;
+
+    using relative_tolerance_type = std::array<scalar_type, state_type::size>;
+
+    static constexpr bool is_state_space_stepper = true;
+    static constexpr bool is_adaptive = true;
+
+    constexpr dormand_prince5()
+        : dormand_prince5(uniform(1e-6),
+                          uniform_relative(1e-6, std::make_index_sequence<state_type::size>{}))
+    {}
+
+    constexpr dormand_prince5(const state_type& abs_tol, const relative_tolerance_type& rel_tol)
+        : abs_tol_{abs_tol}, rel_tol_{rel_tol}
+    {}
+
+    template <class Function>
+    constexpr auto step(Function f, const state_type& x, timepoint_type t, step_type dt)
+        -> std::enable_if_t<is_function<Function, timepoint_type, state_type>::value, state_type>
+    {
+        if (!continues(x, t, dt)) {
+            x_ = x;
+            k1_ = f(t, x);
+            h_ = dt;
+            previous_error_ = min_error;
+        }
+
+        advance(f, t, dt);
+
+        t_ = t + dt;
+        started_ = true;
+
+        return x_;
+    }
+
+  private:
+    /// Integrate `x_` over `dt`, where `k1_` is the derivative at `x_` on entry and at the
+    /// integrated state on exit
+    template <class Function>
+    constexpr auto advance(Function f, timepoint_type t, step_type dt) -> void
+    {
+        // https://en.wikipedia.org/wiki/Dormand%E2%80%93Prince_method
+
+        constexpr auto c2 = scalar_type{1.0 / 5.0};
+        constexpr auto c3 = scalar_type{3.0 / 10.0};
+        constexpr auto c4 = scalar_type{4.0 / 5.0};
+        constexpr auto c5 = scalar_type{8.0 / 9.0};
+
+        constexpr auto a21 = scalar_type{1.0 / 5.0};
+        constexpr auto a31 = scalar_type{3.0 / 40.0};
+        constexpr auto a32 = scalar_type{9.0 / 40.0};
+        constexpr auto a41 = scalar_type{44.0 / 45.0};
+        constexpr auto a42 = scalar_type{-56.0 / 15.0};
+        constexpr auto a43 = scalar_type{32.0 / 9.0};
+        constexpr auto a51 = scalar_type{19372.0 / 6561.0};
+        constexpr auto a52 = scalar_type{-25360.0 / 2187.0};
+        constexpr auto a53 = scalar_type{64448.0 / 6561.0};
+        constexpr auto a54 = scalar_type{-212.0 / 729.0};
+        constexpr auto a61 = scalar_type{9017.0 / 3168.0};
+        constexpr auto a62 = scalar_type{-355.0 / 33.0};
+        constexpr auto a63 = scalar_type{46732.0 / 5247.0};
+        constexpr auto a64 = scalar_type{49.0 / 176.0};
+        constexpr auto a65 = scalar_type{-5103.0 / 18656.0};
+
+        constexpr auto b1 = scalar_type{35.0 / 384.0};
+        constexpr auto b3 = scalar_type{500.0 / 1113.0};
+        constexpr auto b4 = scalar_type{125.0 / 192.0};
+        constexpr auto b5 = scalar_type{-2187.0 / 6784.0};
+        constexpr auto b6 = scalar_type{11.0 / 84.0};
+
+        // Difference between the 5th and 4th order solution weights
+        constexpr auto e1 = scalar_type{71.0 / 57600.0};
+        constexpr auto e3 = scalar_type{-71.0 / 16695.0};
+        constexpr auto e4 = scalar_type{71.0 / 1920.0};
+        constexpr auto e5 = scalar_type{-17253.0 / 339200.0};
+        constexpr auto e6 = scalar_type{22.0 / 525.0};
+        constexpr auto e7 = scalar_type{-1.0 / 40.0};
+
+        const auto t_end = t + dt;
+
+        auto ti = t;
+        auto h = h_;
+        auto rejections = 0;
+
+        while (ti < t_end) {
+            const auto proposed = h;
+            const auto last = !(ti + h < t_end);
+            if (last) {
+                h = t_end - ti;
+            }
+
+            if (!(ti < ti + h)) {
+                throw step_error{"dormand_prince5: step size too small to advance time"};
+            }
+
+            const auto& xi = x_;
+            const auto& k1 = k1_;
+
+            const auto k2 = f(ti + c2 * h, state_type{xi + h * (a21 * k1)});
+            const auto k3 = f(ti + c3 * h, state_type{xi + h * (a31 * k1 + a32 * k2)});
+            const auto k4 =
+                f(ti + c4 * h, state_type{xi + h * (a41 * k1 + a42 * k2 + a43 * k3)});
+            const auto k5 =
+                f(ti + c5 * h, state_type{xi + h * (a51 * k1 + a52 * k2 + a53 * k3 + a54 * k4)});
+            const auto k6 =
+                f(ti + h,
+                  state_type{xi + h * (a61 * k1 + a62 * k2 + a63 * k3 + a64 * k4 + a65 * k5)});
+
+            const state_type xn = xi + h * (b1 * k1 + b3 * k3 + b4 * k4 + b5 * k5 + b6 * k6);
+            const auto k7 = f(ti + h, xn);
+
+            const auto error = error_norm(
+                h * (e1 * k1 + e3 * k3 + e4 * k4 + e5 * k5 + e6 * k6 + e7 * k7), xi, xn);
+
+            // false for a NaN or infinite error, which is rejected with the largest reduction
+            const auto finite = error < std::numeric_limits<double>::infinity();
+
+            if (finite && (error <= 1.0)) {
+                ti = last ? t_end : ti + h;
+                x_ = xn;
+                k1_ = k7;
+                rejections = 0;
+
+                const auto e = detail::max(error, min_error);
+                h = h * scalar_type{detail::min(
+                        max_factor,
+                        detail::max(min_factor,
+                                    safety * detail::pow(e, -alpha) *
+                                        detail::pow(previous_error_, beta)))};
+                previous_error_ = e;
+
+                // a step shortened to end at `t_end` does not limit the steps of the next call
+                h_ = last ? detail::max(h, proposed) : h;
+            } else {
+                if (++rejections > max_rejections) {
+                    throw step_error{"dormand_prince5: too many consecutive rejected steps"};
+                }
+
+                h = h * scalar_type{
+                            finite ? detail::max(min_factor, safety * detail::pow(error, -alpha))
+                                   : min_factor};
+            }
+        }
+    }
+
+    /// Checks if a call starts where the last call ended
+    constexpr auto continues(const state_type& x, timepoint_type t, step_type dt) const -> bool
+    {
+        if (!started_) {
+            return false;
+        }
+
+        // the time of the next call may be computed differently and differ by rounding
+        const auto tolerance = detail::abs(dt) * scalar_type{1e-9};
+        if (tolerance < detail::abs(t - t_)) {
+            return false;
+        }
+
+        auto same = true;
+        x.for_each(equal{same}, x_);
+        return same;
+    }
+
+    // PI step size controller parameters
+    // Hairer 1993 Solving Ordinary Differential Equations I, section II.4
+    static constexpr double safety = 0.9;
+    static constexpr double beta = 0.04;
+    static constexpr double alpha = 0.2 - 0.75 * beta;
+    static constexpr double min_factor = 0.2;
+    static constexpr double max_factor = 10.0;
+    static constexpr double min_error = 1e-4;
+    static constexpr int max_rejections = 100;
+
+    struct equal {
+        template <class T>
+        constexpr auto operator()(const T& lhs, const T& rhs) const -> void
+        {
+            same = same && (lhs == rhs);
+        }
+
+        bool& same;
+    };
+
+    struct fill {
+        template <class T>
+        constexpr auto operator()(T& elem) const -> void
+        {
+            elem = T{value};
+        }
+
+        double value;
+    };
+
+    struct max_error_ratio {
+        template <class Error, class T>
+        constexpr auto operator()(const Error& e, const T& x0, const T& x1, const T& abs_tol)
+            -> void
+        {
+            const auto tol =
+                abs_tol + rel_tol[i++] * detail::max(detail::abs(x0), detail::abs(x1));
+            const auto ratio = static_cast<double>(scalar_type{detail::abs(e) / tol}.value());
+
+            // a NaN ratio is kept so that the step is rejected
+            result = ((result < ratio) || (ratio != ratio)) ? ratio : result;
+        }
+
+        const relative_tolerance_type& rel_tol;
+        std::size_t i;
+        double& result;
+    };
+
+    static constexpr auto uniform(double value) -> state_type
+    {
+        auto x = state_type{};
+        x.for_each(fill{value});
+        return x;
+    }
+
+    template <std::size_t... Is>
+    static constexpr auto uniform_relative(double value, std::index_sequence<Is...>)
+        -> relative_tolerance_type
+    {
+        return {{(static_cast<void>(Is), scalar_type{value})...}};
+    }
+
+    constexpr auto
+    error_norm(const state_type& e, const state_type& x0, const state_type& x1) const
+        -> double
+    {
+        auto result = 0.0;
+        e.for_each(max_error_ratio{rel_tol_, 0, result}, x0, x1, abs_tol_);
+        return result;
+    }
+
+    state_type abs_tol_;
+    relative_tolerance_type rel_tol_;
+
+    // integration carried across calls to `step`
+    state_type x_ = {};
+    deriv_type k1_ = {};
+    timepoint_type t_ = {};
+    step_type h_ = {};
+    double previous_error_ = min_error;
+    bool started_ = false;
+};
+
+template <class State, class Scalar, class Deriv, class StepDuration, class Unused>
+constexpr double dormand_prince5<State, Scalar, Deriv, StepDuration, Unused>::safety;
+template <class State, class Scalar, class Deriv, class StepDuration, class Unused>
+constexpr double dormand_prince5<State, Scalar, Deriv, StepDuration, Unused>::beta;
+template <class State, class Scalar, class Deriv, class StepDuration, class Unused>
+constexpr double dormand_prince5<State, Scalar, Deriv, StepDuration, Unused>::alpha;
+template <class State, class Scalar, class Deriv, class StepDuration, class Unused>
+constexpr double dormand_prince5<State, Scalar, Deriv, StepDuration, Unused>::min_factor;
+template <class State, class Scalar, class Deriv, class StepDuration, class Unused>
+constexpr double dormand_prince5<State, Scalar, Deriv, StepDuration, Unused>::max_factor;
+template <class State, class Scalar, class Deriv, class StepDuration, class Unused>
+constexpr double dormand_prince5<State, Scalar, Deriv, StepDuration, Unused>::min_error;
+template <class State, class Scalar, class Deriv, class StepDuration, class Unused>
+constexpr int dormand_prince5<State, Scalar, Deriv, StepDuration, Unused>::max_rejections;
+
+namespace tableau {
+
+template <class... Coefficients>
+using row = tmp::list<Coefficients...>;
+
+namespace detail {
+
+template <class>
+struct row_size;
+
+template <class... Coefficients>
+struct row_size<row<Coefficients...>> : tmp::index_constant<sizeof...(Coefficients)> {};
+
+}  // namespace detail
+
+/// @brief Butcher tableau of an explicit Runge-Kutta method with rational coefficients
+/// @tparam A `tmp::list` of the rows of the strictly lower triangular matrix, where row `i` holds
+/// the coefficients of the `i` previous stages
+/// @tparam B `row` of weights
+/// @tparam C `row` of nodes
+/// @note Coefficients are specializations of `std::ratio` so that zero and unit coefficients are
+/// known at compile time.
+template <class A, class B, class C>
+struct butcher;
+
+template <class... As, class... Bs, class... Cs>
+struct butcher<tmp::list<As...>, row<Bs...>, row<Cs...>> {
+    using a = tmp::list<As...>;
+    using b = row<Bs...>;
+    using c = row<Cs...>;
+
+    static constexpr std::size_t stages = sizeof...(Bs);
+
+    static_assert(sizeof...(As) == stages, "`A` must have a row for each stage.");
+    static_assert(sizeof...(Cs) == stages, "`C` must have a node for each stage.");
+
+  private:
+    template <std::size_t... Is>
+    static constexpr auto is_strictly_lower_triangular(std::index_sequence<Is...>) -> bool
+    {
+        return tmp::conjunction<tmp::bool_constant<detail::row_size<As>::value == Is>...>::value;
+    }
+
+    static_assert(is_strictly_lower_triangular(std::make_index_sequence<stages>{}),
+                  "Row `i` of `A` must have `i` coefficients.");
+};
+
+template <std::intmax_t Num, std::intmax_t Den = 1>
+using q = std::ratio<Num, Den>;
+
+/// Forward Euler method
+using euler = butcher<tmp::list<row<>>, row<q<1>>, row<q<0>>>;
+
+/// Heun's method
+using heun = butcher<tmp::list<row<>, row<q<1>>>, row<q<1, 2>, q<1, 2>>, row<q<0>, q<1>>>;
+
+/// Kutta's third-order method
+using runge_kutta3 = butcher<tmp::list<row<>, row<q<1, 2>>, row<q<-1>, q<2>>>,
+                             row<q<1, 6>, q<2, 3>, q<1, 6>>,
+                             row<q<0>, q<1, 2>, q<1>>>;
+
+/// Classic fourth-order method
+using runge_kutta4 =
+    butcher<tmp::list<row<>, row<q<1, 2>>, row<q<0>, q<1, 2>>, row<q<0>, q<0>, q<1>>>,
+            row<q<1, 6>, q<1, 3>, q<1, 3>, q<1, 6>>,
+            row<q<0>, q<1, 2>, q<1, 2>, q<1>>>;
+
+/// Fourth-order 3/8-rule method
+using three_eighths = butcher<
+    tmp::list<row<>, row<q<1, 3>>, row<q<-1, 3>, q<1>>, row<q<1>, q<-1>, q<1>>>,
+    row<q<1, 8>, q<3, 8>, q<3, 8>, q<1, 8>>,
+    row<q<0>, q<1, 3>, q<2, 3>, q<1>>>;
+
+/// Fifth-order solution of the Cash-Karp method
+/// Cash 1990 A variable order Runge-Kutta method for initial value problems with rapidly varying
+/// right-hand sides
+using cash_karp = butcher<
+    tmp::list<row<>,
+              row<q<1, 5>>,
+              row<q<3, 40>, q<9, 40>>,
+              row<q<3, 10>, q<-9, 10>, q<6, 5>>,
+              row<q<-11, 54>, q<5, 2>, q<-70, 27>, q<35, 27>>,
+              row<q<1631, 55296>, q<175, 512>, q<575, 13824>, q<44275, 110592>, q<253, 4096>>>,
+    row<q<37, 378>, q<0>, q<250, 621>, q<125, 594>, q<0>, q<512, 1771>>,
+    row<q<0>, q<1, 5>, q<3, 10>, q<3, 5>, q<1>, q<7, 8>>>;
+
+template <class... As, class... Bs, class... Cs>
+constexpr std::size_t butcher<tmp::list<As...>, row<Bs...>, row<Cs...>>::stages;
+
+}  // namespace tableau
+
+/// @brief Explicit Runge-Kutta stepper defined by a Butcher tableau
+/// @tparam Tableau specialization of `tableau::butcher`
+/// @note Stages are unrolled at compile time. Terms with a zero coefficient are omitted and unit
+/// coefficients are not multiplied, so a tableau costs no more arithmetic than writing out its
+/// stages by hand.
+template <class Tableau,
+          class State,
+          class Scalar,
+          class Deriv,
+          class StepDuration,
+          class Unused = void>
+struct explicit_runge_kutta {
+    using state_type = State;
+    using scalar_type = Scalar;
+    using deriv_type = Deriv;
+    using step_type = StepDuration;
+    using timepoint_type = StepDuration;
+
+    using tableau_type = Tableau;
+
+    static constexpr bool is_state_space_stepper = true;
+    static constexpr std::size_t stages = tableau_type::stages;
+
+    template <class Function>
+    static constexpr auto step(Function f, const state_type& x, timepoint_type t, step_type dt)
+        -> std::enable_if_t<is_function<Function, timepoint_type, state_type>::value, state_type>
+    {
+        return evaluate_stages(
+            f, x, t, dt, typename tableau_type::a{}, typename tableau_type::c{});
+    }
+
+  private:
+    // Result of a weighted sum in which every coefficient is zero
+    struct zero {};
+
+    template <class R>
+    using is_zero = std::ratio_equal<R, std::ratio<0>>;
+
+    template <class R>
+    using is_one = std::ratio_equal<R, std::ratio<1>>;
+
+    template <class R>
+    static constexpr auto coefficient() -> scalar_type
+    {
+        return scalar_type{static_cast<double>(R::num) / static_cast<double>(R::den)};
+    }
+
+    // Product of a coefficient, the step and a stage derivative, with the coefficient folded into
+    // the step so that each term costs a single multiplication of a derivative
+    template <class R>
+    static constexpr auto term(step_type dt, const deriv_type& k)
+    {
+        return term<R>(dt, k, is_zero<R>{}, is_one<R>{});
+    }
+
+    template <class R>
+    static constexpr auto term(step_type, const deriv_type&, std::true_type, std::false_type)
+        -> zero
+    {
+        return {};
+    }
+
+    template <class R>
+    static constexpr auto term(step_type dt, const deriv_type& k, std::false_type, std::true_type)
+    {
+        return dt * k;
+    }
+
+    template <class R>
+    static constexpr auto term(step_type dt, const deriv_type& k, std::false_type, std::false_type)
+    {
+        return (coefficient<R>() * dt) * k;
+    }
+
+    static constexpr auto add(zero, zero) -> zero { return {}; }
+
+    template <class Lhs>
+    static constexpr auto add(const Lhs& lhs, zero) -> Lhs
+    {
+        return lhs;
+    }
+
+    template <class Rhs>
+    static constexpr auto add(zero, const Rhs& rhs) -> Rhs
+    {
+        return rhs;
+    }
+
+    template <class Lhs, class Rhs>
+    static constexpr auto add(const Lhs& lhs, const Rhs& rhs)
+    {
+        return lhs + rhs;
+    }
+
+    static constexpr auto weighted_sum(step_type, tableau::row<>) -> zero { return {}; }
+
+    template <class R, class... Rs, class... Ks>
+    static constexpr auto
+    weighted_sum(step_type dt, tableau::row<R, Rs...>, const deriv_type& k, const Ks&... ks)
+    {
+        return add(term<R>(dt, k), weighted_sum(dt, tableau::row<Rs...>{}, ks...));
+    }
+
+    static constexpr auto increment(const state_type& x, zero) -> state_type { return x; }
+
+    // Evaluates the weighted sum of stage derivatives and its sum with the state in one pass
+    template <class Increment>
+    static constexpr auto increment(const state_type& x, const Increment& dx) -> state_type
+    {
+        return x + dx;
+    }
+
+    template <class R>
+    static constexpr auto node(timepoint_type t, step_type dt) -> timepoint_type
+    {
+        return node<R>(t, dt, is_zero<R>{}, is_one<R>{});
+    }
+
+    template <class R>
+    static constexpr auto node(timepoint_type t, step_type, std::true_type, std::false_type)
+        -> timepoint_type
+    {
+        return t;
+    }
+
+    template <class R>
+    static constexpr auto node(timepoint_type t, step_type dt, std::false_type, std::true_type)
+        -> timepoint_type
+    {
+        return t + dt;
+    }
+
+    template <class R>
+    static constexpr auto node(timepoint_type t, step_type dt, std::false_type, std::false_type)
+        -> timepoint_type
+    {
+        return t + coefficient<R>() * dt;
+    }
+
+    // Evaluates the next stage from the derivatives of the previous stages `ks`
+    template <class Function, class A, class... As, class C, class... Cs, class... Ks>
+    static constexpr auto evaluate_stages(const Function& f,
+                                          const state_type& x,
+                                          timepoint_type t,
+                                          step_type dt,
+                                          tmp::list<A, As...>,
+                                          tableau::row<C, Cs...>,
+                                          const Ks&... ks) -> state_type
+    {
+        return evaluate_stages(f,
+                               x,
+                               t,
+                               dt,
+                               tmp::list<As...>{},
+                               tableau::row<Cs...>{},
+                               ks...,
+                               f(node<C>(t, dt), increment(x, weighted_sum(dt, A{}, ks...))));
+    }
+
+    template <class Function, class... Ks>
+    static constexpr auto evaluate_stages(const Function&,
+                                          const state_type& x,
+                                          timepoint_type,
+                                          step_type dt,
+                                          tmp::list<>,
+                                          tableau::row<>,
+                                          const Ks&... ks) -> state_type
+    {
+        return increment(x, weighted_sum(dt, typename tableau_type::b{}, ks...));
+    }
+};
+
+template <class Tableau,
+          class State,
+          class Scalar,
+          class Deriv,
+          class StepDuration,
+          class Unused>
+constexpr std::size_t
+    explicit_runge_kutta<Tableau, State, Scalar, Deriv, StepDuration, Unused>::stages;
+
+template <class State, class Scalar, class Deriv, class StepDuration, class Unused = void>
+using euler = explicit_runge_kutta<tableau::euler, State, Scalar, Deriv, StepDuration, Unused>;
+
+template <class State, class Scalar, class Deriv, class StepDuration, class Unused = void>
+using heun = explicit_runge_kutta<tableau::heun, State, Scalar, Deriv, StepDuration, Unused>;
+
+template <class State, class Scalar, class Deriv, class StepDuration, class Unused = void>
+using runge_kutta3 =
+    explicit_runge_kutta<tableau::runge_kutta3, State, Scalar, Deriv, StepDuration, Unused>;
+
+/// @note Equivalent to `runge_kutta4`, which additionally provides dense output.
+template <class State, class Scalar, class Deriv, class StepDuration, class Unused = void>
+using classic_runge_kutta4 =
+    explicit_runge_kutta<tableau::runge_kutta4, State, Scalar, Deriv, StepDuration, Unused>;
+
+template <class State, class Scalar, class Deriv, class StepDuration, class Unused = void>
+using three_eighths_runge_kutta4 =
+    explicit_runge_kutta<tableau::three_eighths, State, Scalar, Deriv, StepDuration, Unused>;
+
+/// @note Integrates with the fifth-order weights only, without step size control.
+template <class State, class Scalar, class Deriv, class StepDuration, class Unused = void>
+using cash_karp5 =
+    explicit_runge_kutta<tableau::cash_karp, State, Scalar, Deriv, StepDuration, Unused>;
+
+/// @brief Linearly implicit Rosenbrock stepper of order 3 for stiff systems
+/// Lang, Verwer 2001 ROS3P - An accurate third-order Rosenbrock solver designed for parabolic
+/// problems
+/// @note The method is A-stable, so the step size of a stiff system is limited by accuracy
+/// rather than by stability. Each step evaluates the Jacobian J of the system with respect to the
+/// state once, factorizes I / (gamma dt) - J once and solves a linear system for each of its
+/// three stages.
+/// @note `f` must provide the Jacobian as `f.jacobian(t, x)`, returning a matrix with a
+/// `for_each(v)` calling `v(i, j, entry)` for each entry. Systems provide this when integrating
+/// with an implicit stepper, either from an analytic Jacobian of the transition function or with
+/// forward-mode automatic differentiation.
+/// @note The time derivative of `f` is neglected, which is exact for time-invariant systems.
+/// Linear systems are solved in double precision with the value of each element in its unit.
+/// @note Throws `step_error` if the iteration matrix is singular, such as when 1 / (gamma dt) is
+/// an eigenvalue of J or J is not finite.
+template <class State, class Scalar, class Deriv, class StepDuration, class Unused = void>
+struct rosenbrock3 {
+    using state_type = State;
+    using scalar_type = Scalar;
+    using deriv_type = Deriv;
+    using step_type = StepDuration;
+    using timepoint_type = StepDuration;
+
+    static constexpr bool is_state_space_stepper = true;
+    static constexpr bool requires_jacobian = true;
+
+    template <class Function>
+    static constexpr auto step(Function f, const state_type& x, timepoint_type t, step_type dt)
+        -> std::enable_if_t<is_function<Function, timepoint_type, state_type>::value, state_type>
+    {
+        static_assert(has_jacobian<Function, timepoint_type, state_type>::value,
+                      "`rosenbrock3` requires a function providing `jacobian(t, x)`.");
+
+        // Coefficients of the form without matrix-vector products, Hairer, Wanner 1996 Solving
+        // Ordinary Differential Equations II (IV.7.25)
+        constexpr auto gamma = 7.886751345948128822e-01;
+
+        constexpr auto a21 = scalar_type{1.267949192431122706};
+        constexpr auto a31 = scalar_type{1.267949192431122706};
+
+        constexpr auto c21 = -1.607695154586736461;
+        constexpr auto c31 = -3.464101615137754587;
+        constexpr auto c32 = -1.732050807568877294;
+
+        constexpr auto m1 = scalar_type{2.0};
+        constexpr auto m2 = scalar_type{5.773502691896257645e-01};
+        constexpr auto m3 = scalar_type{4.226497308103742355e-01};
+
+        const auto h = dt.value();
+
+        matrix_type m = {};
+        f.jacobian(t, x).for_each(iteration_matrix{m, 1.0 / (gamma * h)});
+
+        const auto lu = lu_decomposition<double, n>{m};
+        if (lu.singular()) {
+            throw step_error{"rosenbrock3: singular iteration matrix"};
+        }
+
+        const auto u1 = solve(lu, f(t, x));
+        const auto u2 = solve(lu, f(t + dt, state_type{x + a21 * u1}), c21 / h, u1);
+        const auto u3 = solve(lu, f(t + dt, state_type{x + a31 * u1}), c31 / h, u1, c32 / h, u2);
+
+        return x + m1 * u1 + m2 * u2 + m3 * u3;
+    }
+
+  private:
+    static constexpr std::size_t n = state_type::size;
+
+    using matrix_type = double[n][n];
+    using vector_type = double[n];
+
+    /// Fill with I / (gamma dt) - J
+    struct iteration_matrix {
+        template <class Entry>
+        constexpr auto operator()(std::size_t i, std::size_t j, const Entry& entry) -> void
+        {
+            m[i][j] = ((i == j) ? diagonal : 0.0) - static_cast<double>(entry.value());
+        }
+
+        matrix_type& m;
+        double diagonal;
+    };
+
+    /// Accumulate the scaled values of the elements of a vector
+    struct accumulate {
+        template <class T>
+        constexpr auto operator()(const T& elem) -> void
+        {
+            b[i++] += scale * static_cast<double>(elem.value());
+        }
+
+        vector_type& b;
+        double scale;
+        std::size_t i;
+    };
+
+    struct assign {
+        template <class T>
+        constexpr auto operator()(T& elem) -> void
+        {
+            elem = T{b[i++]};
+        }
+
+        const vector_type& b;
+        std::size_t i;
+    };
+
+    /// Solve for a stage given the derivative at the stage and the scaled previous stages
+    template <class... Stages>
+    static constexpr auto solve(const lu_decomposition<double, n>& lu,
+                                const deriv_type& dxdt,
+                                const Stages&... stages) -> state_type
+    {
+        vector_type b = {};
+
+        dxdt.for_each(accumulate{b, 1.0, 0});
+        add_stages(b, stages...);
+
+        lu.solve(b);
+
+        auto u = state_type{};
+        u.for_each(assign{b, 0});
+        return u;
+    }
+
+    static constexpr auto add_stages(vector_type&) -> void {}
+
+    template <class... Stages>
+    static constexpr auto
+    add_stages(vector_type& b, double c, const state_type& u, const Stages&... stages) -> void
+    {
+        u.for_each(accumulate{b, c, 0});
+        add_stages(b, stages...);
+    }
+};
+
 }  // namespace stepper
 }  // namespace ode
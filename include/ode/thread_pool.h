@@ -0,0 +1,277 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif  // __linux__
+
+namespace ode {
+
+/// @brief A fixed size pool of threads executing parallel loops by work stealing
+/// @note The iterations of a loop are split into one contiguous range per worker. A worker
+/// executes its own range in chunks of `grain` iterations and, once empty, steals the upper half
+/// of the range of another worker.
+/// @note The thread calling `parallel_for` participates as the first worker, so a pool with a
+/// single thread executes loops sequentially on the calling thread. `parallel_for` must not be
+/// called concurrently or recursively on the same pool.
+class thread_pool {
+  public:
+    static auto default_thread_count() noexcept -> std::size_t
+    {
+        return std::max(std::size_t{1}, std::size_t{std::thread::hardware_concurrency()});
+    }
+
+    /// @param threads total number of workers, including the calling thread
+    /// @param pin_threads if true, worker `i` is pinned to core `i` modulo the number of cores.
+    /// The calling thread is not pinned. Pinning is only supported on Linux.
+    explicit thread_pool(std::size_t threads = default_thread_count(), bool pin_threads = false)
+        : size_{std::max(threads, std::size_t{1})}, workers_{new worker[size_]}
+    {
+        threads_.reserve(size_ - 1);
+
+        for (auto i = std::size_t{1}; i < size_; ++i) {
+            threads_.emplace_back([this, i] { run(i); });
+
+            if (pin_threads) {
+                pin(threads_.back(), i);
+            }
+        }
+    }
+
+    thread_pool(const thread_pool&) = delete;
+    auto operator=(const thread_pool&) -> thread_pool& = delete;
+
+    ~thread_pool()
+    {
+        {
+            std::lock_guard<std::mutex> lock{mutex_};
+            stop_ = true;
+        }
+        wake_.notify_all();
+
+        for (auto& t : threads_) {
+            t.join();
+        }
+    }
+
+    auto size() const noexcept -> std::size_t { return size_; }
+
+    /// Call `f(i)` for each `i` in [0, n), returning once all calls have completed
+    /// @note `f` is called concurrently from multiple threads. If a call throws, the iterations
+    /// not yet started are skipped and the first exception is rethrown once every worker has
+    /// finished the loop.
+    template <class Function>
+    auto parallel_for(std::size_t n, Function f, std::size_t grain = 1) -> void
+    {
+        const auto task = [](void* context, std::size_t first, std::size_t last) {
+            auto& g = *static_cast<Function*>(context);
+            for (auto i = first; i < last; ++i) {
+                g(i);
+            }
+        };
+
+        dispatch(n, std::max(grain, std::size_t{1}), task, &f);
+    }
+
+  private:
+    using task_type = void (*)(void*, std::size_t, std::size_t);
+
+    struct worker {
+        std::mutex mutex;
+        std::size_t begin = 0;
+        std::size_t end = 0;
+
+        // Avoids false sharing between adjacent workers without over-aligned allocation, which
+        // is not supported until C++17.
+        char padding[64];
+    };
+
+    static auto pin(std::thread& t, std::size_t i) -> void
+    {
+#ifdef __linux__
+        auto cpus = cpu_set_t{};
+        CPU_ZERO(&cpus);
+        CPU_SET(static_cast<int>(i % default_thread_count()), &cpus);
+        pthread_setaffinity_np(t.native_handle(), sizeof(cpus), &cpus);
+#else
+        (void)t;
+        (void)i;
+#endif  // __linux__
+    }
+
+    auto dispatch(std::size_t n, std::size_t grain, task_type task, void* context) -> void
+    {
+        if (n == 0) {
+            return;
+        }
+
+        for (auto i = std::size_t{}; i < size_; ++i) {
+            std::lock_guard<std::mutex> lock{workers_[i].mutex};
+            workers_[i].begin = n * i / size_;
+            workers_[i].end = n * (i + 1) / size_;
+        }
+
+        remaining_.store(n, std::memory_order_release);
+
+        {
+            std::lock_guard<std::mutex> lock{mutex_};
+            task_ = task;
+            context_ = context;
+            grain_ = grain;
+            active_ = size_ - 1;
+            ++generation_;
+        }
+        wake_.notify_all();
+
+        execute(0);
+
+        // Workers must not observe the next loop while still executing this one.
+        std::unique_lock<std::mutex> lock{mutex_};
+        done_.wait(lock, [this] { return active_ == 0; });
+
+        failed_.store(false, std::memory_order_relaxed);
+        if (error_) {
+            std::rethrow_exception(std::exchange(error_, nullptr));
+        }
+    }
+
+    auto run(std::size_t self) -> void
+    {
+        auto seen = std::size_t{};
+
+        for (;;) {
+            {
+                std::unique_lock<std::mutex> lock{mutex_};
+                wake_.wait(lock, [this, seen] { return stop_ || (generation_ != seen); });
+
+                if (stop_) {
+                    return;
+                }
+                seen = generation_;
+            }
+
+            execute(self);
+
+            {
+                std::lock_guard<std::mutex> lock{mutex_};
+                if (--active_ == 0) {
+                    done_.notify_one();
+                }
+            }
+        }
+    }
+
+    auto execute(std::size_t self) noexcept -> void
+    {
+        while (remaining_.load(std::memory_order_acquire) > 0) {
+            auto first = std::size_t{};
+            auto last = std::size_t{};
+
+            if (take(self, first, last) || steal(self, first, last)) {
+                execute(first, last);
+                remaining_.fetch_sub(last - first, std::memory_order_acq_rel);
+            } else {
+                std::this_thread::yield();
+            }
+        }
+    }
+
+    /// Executes the iterations in [first, last) unless a previous chunk of the loop threw,
+    /// keeping the first exception
+    auto execute(std::size_t first, std::size_t last) noexcept -> void
+    {
+        if (failed_.load(std::memory_order_relaxed)) {
+            return;
+        }
+
+        try {
+            task_(context_, first, last);
+        } catch (...) {
+            std::lock_guard<std::mutex> lock{mutex_};
+            if (!error_) {
+                error_ = std::current_exception();
+            }
+            failed_.store(true, std::memory_order_relaxed);
+        }
+    }
+
+    auto take(std::size_t self, std::size_t& first, std::size_t& last) -> bool
+    {
+        auto& w = workers_[self];
+        std::lock_guard<std::mutex> lock{w.mutex};
+
+        if (w.begin == w.end) {
+            return false;
+        }
+
+        first = w.begin;
+        last = std::min(w.begin + grain_, w.end);
+        w.begin = last;
+
+        return true;
+    }
+
+    auto steal(std::size_t self, std::size_t& first, std::size_t& last) -> bool
+    {
+        for (auto k = std::size_t{1}; k < size_; ++k) {
+            auto& victim = workers_[(self + k) % size_];
+
+            auto begin = std::size_t{};
+            auto end = std::size_t{};
+            {
+                std::lock_guard<std::mutex> lock{victim.mutex};
+
+                if (victim.begin == victim.end) {
+                    continue;
+                }
+
+                begin = victim.begin + (victim.end - victim.begin) / 2;
+                end = victim.end;
+                victim.end = begin;
+            }
+
+            {
+                auto& w = workers_[self];
+                std::lock_guard<std::mutex> lock{w.mutex};
+                w.begin = begin;
+                w.end = end;
+            }
+
+            return take(self, first, last);
+        }
+
+        return false;
+    }
+
+    std::size_t size_;
+    std::unique_ptr<worker[]> workers_;
+    std::vector<std::thread> threads_;
+
+    std::mutex mutex_;
+    std::condition_variable wake_;
+    std::condition_variable done_;
+    std::size_t generation_ = 0;
+    std::size_t active_ = 0;
+    bool stop_ = false;
+
+    task_type task_ = nullptr;
+    void* context_ = nullptr;
+    std::size_t grain_ = 1;
+    std::atomic<std::size_t> remaining_{0};
+
+    std::atomic<bool> failed_{false};
+    std::exception_ptr error_;
+};
+
+}  // namespace ode
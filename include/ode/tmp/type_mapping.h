@@ -10,41 +10,99 @@ namespace mapping {
 
 namespace detail {
 
+// Elements are matched as `std::pair` without instantiating it
 template <class T>
-struct get_first {
-    using type = typename T::first_type;
+struct get_first;
+
+template <class K, class V>
+struct get_first<std::pair<K, V>> {
+    using type = K;
+};
+
+template <class T>
+struct get_second;
+
+template <class K, class V>
+struct get_second<std::pair<K, V>> {
+    using type = V;
+};
+
+/// @brief An element of a mapping, an empty class that is cheaper to instantiate than the
+/// `std::pair` it is made from
+/// @note Lookups call friend functions found by argument-dependent lookup on a type deriving from
+/// every entry of a mapping, as in `tmp::at`.
+template <class Key, class Value>
+struct entry {
+    friend auto mapped_value(type_identity<Key>*, const entry*) -> type_identity<Value>
+    {
+        return {};
+    }
+
+    friend auto mapped_key(type_identity<Value>*, const entry*) -> type_identity<Key>
+    {
+        return {};
+    }
 };
 
+struct not_found {};
+
 template <class T>
-struct get_second {
-    using type = typename T::second_type;
+struct make_entry {
+    using type = entry<T, void>;
+};
+
+template <class K, class V>
+struct make_entry<std::pair<K, V>> {
+    using type = entry<K, V>;
 };
 
+template <class... Ts>
+using entries = inheritor<typename make_entry<Ts>::type...>;
+
+auto mapped_value(...) -> not_found;
+
+auto mapped_key(...) -> not_found;
+
+template <class T, class Default>
+struct found_or {
+    using type = typename T::type;
+};
+
+template <class Default>
+struct found_or<not_found, Default> {
+    using type = Default;
+};
+
+// Lookups are performed within a class template so that each is only performed once
+template <class Entries, class Key, class Default>
+struct value_at_key
+    : found_or<decltype(mapped_value(static_cast<type_identity<Key>*>(nullptr),
+                                     static_cast<const Entries*>(nullptr))),
+               Default> {};
+
+template <class Entries, class Value, class Default>
+struct key_at_value
+    : found_or<decltype(mapped_key(static_cast<type_identity<Value>*>(nullptr),
+                                   static_cast<const Entries*>(nullptr))),
+               Default> {};
+
 }  // namespace detail
 
 /// @brief A metatype defining a mapping where Ts... is a collection of std::pair<key, value> and
 /// all keys are unique.
 template <class... Ts>
-struct surjection : inheritor<Ts...> {
-    static_assert(conjunction<is_specialization_of<Ts, std::pair>...>::value,
+struct surjection : detail::entries<Ts...> {
+    static_assert(all_of<is_specialization_of<Ts, std::pair>...>::value,
                   "A mapping must be composed of elements of type `std::pair`.");
 
     using type = surjection;
     using keys = map<detail::get_first, list<Ts...>>;
     using values = make_unique<map<detail::get_second, list<Ts...>>>;
 
-    static_assert(std::is_same<keys, make_unique<keys>>::value,
-                  "A mapping cannot contain duplicate keys.");
-
-    template <class, class Default>
-    static constexpr auto at_key_impl(...) -> Default;
-
-    template <class Key, class, class Value>
-    static constexpr auto at_key_impl(std::pair<Key, Value>*) -> Value;
+    static_assert(is_unique<keys>::value, "A mapping cannot contain duplicate keys.");
 
     template <class Key, class Default = void>
-    using at_key =
-        decltype(surjection::at_key_impl<Key, Default>(std::declval<inheritor<Ts...>*>()));
+    using at_key = typename detail::value_at_key<detail::entries<Ts...>, Key, Default>::type;
 
     template <class Key>
     using contains_key = negation<std::is_same<void, at_key<Key>>>;
@@ -59,18 +117,10 @@ struct bijection : surjection<Ts...> {
     using keys = map<detail::get_first, list<Ts...>>;
     using values = map<detail::get_second, list<Ts...>>;
 
-    static_assert(std::is_same<values, make_unique<values>>::value,
-                  "A bijection cannot contain duplicate values.");
-
-    template <class, class Default>
-    static constexpr auto at_value_impl(...) -> Default;
-
-    template <class Value, class, class Key>
-    static constexpr auto at_value_impl(std::pair<Key, Value>*) -> Key;
+    static_assert(is_unique<values>::value, "A bijection cannot contain duplicate values.");
 
     template <class Value, class Default = void>
-    using at_value =
-        decltype(bijection::at_value_impl<Value, Default>(std::declval<inheritor<Ts...>*>()));
+    using at_value = typename detail::key_at_value<detail::entries<Ts...>, Value, Default>::type;
 
     template <class Value>
     using contains_value = negation<std::is_same<void, at_value<Value>>>;
@@ -79,22 +129,20 @@ struct bijection : surjection<Ts...> {
 
 namespace detail {
 
-template <class... Ts>
+template <class Keys, class Indices>
 struct index_map_impl;
 
-template <class... Ts, class K, class... Ks>
-struct index_map_impl<list<Ts...>, K, Ks...>
-    : index_map_impl<list<Ts..., std::pair<K, index_constant<sizeof...(Ts)>>>, Ks...> {};
-
-template <class... Ts>
-struct index_map_impl<list<Ts...>> : bijection<Ts...> {};
+template <class... Ks, std::size_t... Is>
+struct index_map_impl<list<Ks...>, std::index_sequence<Is...>>
+    : bijection<std::pair<Ks, index_constant<Is>>...> {};
 
 }  // namespace detail
 
 /// @brief A metatype defining a mapping where Ks... is a collection of keys, which are unique. A
 /// unique index is assigned to each key.
 template <class... Ks>
-using index_map = typename detail::index_map_impl<list<>, Ks...>::type;
+using index_map =
+    typename detail::index_map_impl<list<Ks...>, std::index_sequence_for<Ks...>>::type;
 
 }  // namespace mapping
 }  // namespace tmp
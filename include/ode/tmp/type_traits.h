@@ -75,25 +75,80 @@ struct disjunction<B1, Bn...> : std::conditional_t<bool(B1::value), B1, disjunct
 template <class B>
 struct negation : std::integral_constant<bool, !bool(B::value)> {};
 
+namespace detail {
+
+template <class, bool B>
+using constant_for = bool_constant<B>;
+
+}  // namespace detail
+
+/// @brief Variadic logical AND metafunction of constant instantiation depth
+/// @note Unlike `conjunction`, `value` is evaluated for every type in `Bs...`.
+template <class... Bs>
+using all_of = std::is_same<list<bool_constant<bool(Bs::value)>...>,
+                            list<detail::constant_for<Bs, true>...>>;
+
+/// @brief Variadic logical OR metafunction of constant instantiation depth
+/// @note Unlike `disjunction`, `value` is evaluated for every type in `Bs...`.
+template <class... Bs>
+using any_of = negation<std::is_same<list<bool_constant<bool(Bs::value)>...>,
+                                     list<detail::constant_for<Bs, false>...>>>;
+
 /// @brief Stores `Count` number of repetitions of type `T` in a `list`
 namespace detail {
 
-template <int, class...>
+template <class T, std::size_t>
+using repeat_element = T;
+
+template <class T, class Indices>
 struct repeat_impl;
 
-template <int N, class T, class... Ts>
-struct repeat_impl<N, T, list<Ts...>> : std::conditional_t<(N <= 0),
-                                                           repeat_impl<N, list<Ts...>>,
-                                                           repeat_impl<N - 1, T, list<T, Ts...>>> {
+template <class T, std::size_t... Is>
+struct repeat_impl<T, std::index_sequence<Is...>> : list<repeat_element<T, Is>...> {};
+
+}  // namespace detail
+
+template <int Count, class T>
+using repeat =
+    typename detail::repeat_impl<T, std::make_index_sequence<(Count > 0) ? Count : 0>>::type;
+
+/// @brief Obtain the element at index `I` of a list
+/// @note Each element is paired with its index in a base class of a single type, declaring
+/// friend functions found by argument-dependent lookup on that type. Lookup neither recurses
+/// over the list nor deduces a base class, which is considerably slower for long lists.
+namespace detail {
+
+template <std::size_t I, class T>
+struct indexed {
+    using type = T;
+
+    friend auto element_at(index_constant<I>*, const indexed*) -> indexed { return {}; }
+
+    friend auto index_of(type_identity<T>*, const indexed*) -> indexed { return {}; }
 };
 
-template <int N, class... Ts>
-struct repeat_impl<N, list<Ts...>> : list<Ts...> {};
+template <class L, class Indices>
+struct indexer_impl;
+
+template <class... Ts, std::size_t... Is>
+struct indexer_impl<list<Ts...>, std::index_sequence<Is...>> : indexed<Is, Ts>... {};
+
+template <class L>
+struct indexer;
+
+template <class... Ts>
+struct indexer<list<Ts...>> : indexer_impl<list<Ts...>, std::index_sequence_for<Ts...>> {};
+
+template <std::size_t I, class L>
+struct at_impl {
+    using type = typename decltype(element_at(static_cast<index_constant<I>*>(nullptr),
+                                              static_cast<const indexer<L>*>(nullptr)))::type;
+};
 
 }  // namespace detail
 
-template <int Count, class T>
-using repeat = typename detail::repeat_impl<Count, T, list<>>::type;
+template <std::size_t I, class L>
+using at = typename detail::at_impl<I, L>::type;
 
 /// @brief Pushes `T` to the front of list `L`
 namespace detail {
@@ -148,12 +203,27 @@ constexpr auto abs(Int n) noexcept -> std::enable_if_t<std::is_signed<Int>::valu
 /// @brief Drop the first n elements in a list
 namespace detail {
 
+template <class Indices>
+struct drop_front;
+
+// The first elements are matched by parameters of type `const void*`, deducing the remainder
+template <std::size_t... Is>
+struct drop_front<std::index_sequence<Is...>> {
+    template <class... Ts>
+    static auto apply(repeat_element<const void*, Is>..., type_identity<Ts>*...) -> list<Ts...>;
+};
+
 template <int N, class L>
 struct drop_impl;
 
-template <int N, class T, class... Ts>
-struct drop_impl<N, list<T, Ts...>>
-    : std::conditional_t<(N <= 0), list<T, Ts...>, drop_impl<N - 1, list<Ts...>>> {};
+template <int N, class... Ts>
+struct drop_impl<N, list<Ts...>> {
+    static_assert(N <= static_cast<int>(sizeof...(Ts)),
+                  "Cannot drop more elements than a list contains.");
+
+    using type = decltype(drop_front<std::make_index_sequence<(N > 0) ? N : 0>>::apply(
+        static_cast<type_identity<Ts>*>(nullptr)...));
+};
 
 }  // namespace detail
 
@@ -163,51 +233,74 @@ using drop = typename detail::drop_impl<N, L>::type;
 /// @brief Skip every n-th element in a list
 namespace detail {
 
-template <int N, int I, class R, class T>
+template <std::size_t Stride, class L, class Indices>
 struct skip_impl;
 
-template <int N, int I, class... Rs, class T, class... Ts>
-struct skip_impl<N, I, list<Rs...>, list<T, Ts...>>
-    : std::conditional_t<(I == 0),
-                         skip_impl<N, N, list<Rs..., T>, list<Ts...>>,
-                         skip_impl<N, I - 1, list<Rs...>, list<Ts...>>> {
-    static_assert(N > 0, "");
-};
+template <std::size_t Stride, class L, std::size_t... Is>
+struct skip_impl<Stride, L, std::index_sequence<Is...>> : list<at<Is * Stride, L>...> {};
 
-template <int N, int I, class... Rs>
-struct skip_impl<N, I, list<Rs...>, list<>> : list<Rs...> {};
+template <int N, class L>
+struct skip_list;
 
-template <class... Ts>
-struct skip_impl<0, 0, list<>, list<Ts...>> : list<Ts...> {};
+template <int N, class... Ts>
+struct skip_list<N, list<Ts...>>
+    : skip_impl<N + 1,
+                list<Ts...>,
+                std::make_index_sequence<(sizeof...(Ts) + N) / (N + 1)>> {
+    static_assert(N >= 0, "");
+};
 
 }  // namespace detail
 
 template <int N, class L>
-using skip = typename detail::skip_impl<N, 0, list<>, L>::type;
+using skip = typename detail::skip_list<N, L>::type;
 
 /// @brief Map a metafunction `Func` to a list of types
 namespace detail {
 
-template <template <class> class Func, class R, class T>
+template <template <class> class Func, class L>
 struct map_impl;
 
-template <template <class> class Func, class... Rs, class T, class... Ts>
-struct map_impl<Func, list<Rs...>, list<T, Ts...>>
-    : map_impl<Func, list<Rs..., typename Func<T>::type>, list<Ts...>> {};
-
-template <template <class> class Func, class... Rs>
-struct map_impl<Func, list<Rs...>, list<>> : list<Rs...> {};
+template <template <class> class Func, class... Ts>
+struct map_impl<Func, list<Ts...>> : list<typename Func<Ts>::type...> {};
 
 }  // namespace detail
 
 template <template <class> class Func, class L>
-using map = typename detail::map_impl<Func, list<>, L>::type;
+using map = typename detail::map_impl<Func, L>::type;
 
 /// @brief Check if type K is contained within a list of types
 template <class K, class L>
 using contains = std::is_base_of<K, rebind_outer<L, list, inheritor>>;
 
+/// @brief Check if each type in a list occurs once
+/// @note Finding the index of a type that occurs more than once is ambiguous and fails.
+namespace detail {
+
+template <class T, class L, class = void>
+struct occurs_once : std::false_type {};
+
+template <class T, class L>
+struct occurs_once<T,
+                   L,
+                   void_t<decltype(index_of(static_cast<type_identity<T>*>(nullptr),
+                                            static_cast<const indexer<L>*>(nullptr)))>>
+    : std::true_type {};
+
+template <class L>
+struct is_unique_impl;
+
+template <class... Ts>
+struct is_unique_impl<list<Ts...>> : all_of<occurs_once<Ts, list<Ts...>>...> {};
+
+}  // namespace detail
+
+template <class L>
+using is_unique = typename detail::is_unique_impl<L>::type;
+
 /// @brief Return a list of unique types
+/// @note A list without duplicates is returned as is. Otherwise, duplicates are removed by
+/// recursing over the list.
 namespace detail {
 
 template <class R, class T>
@@ -225,44 +318,73 @@ struct make_unique_impl<list<Rs...>, list<>> : list<Rs...> {};
 }  // namespace detail
 
 template <class L>
-using make_unique = typename detail::make_unique_impl<list<>, L>::type;
+using make_unique = typename std::conditional_t<is_unique<L>::value,
+                                                type_identity<L>,
+                                                detail::make_unique_impl<list<>, L>>::type;
 
 /// @brief Zip together two lists
 namespace detail {
 
-template <class R, class L1, class L2>
+template <class L1, class L2>
 struct zip_impl;
 
-template <class... Rs, class T1, class... T1s, class T2, class... T2s>
-struct zip_impl<list<Rs...>, list<T1, T1s...>, list<T2, T2s...>>
-    : zip_impl<list<Rs..., std::pair<T1, T2>>, list<T1s...>, list<T2s...>> {};
-
-template <class... Rs>
-struct zip_impl<list<Rs...>, list<>, list<>> : list<Rs...> {};
+template <class... T1s, class... T2s>
+struct zip_impl<list<T1s...>, list<T2s...>> : list<std::pair<T1s, T2s>...> {
+    static_assert(sizeof...(T1s) == sizeof...(T2s), "Zipped lists must be of equal size.");
+};
 
 }  // namespace detail
 
 template <class L1, class L2>
-using zip = typename detail::zip_impl<list<>, L1, L2>::type;
+using zip = typename detail::zip_impl<L1, L2>::type;
 
 /// @brief Interleave together two lists
 namespace detail {
 
-template <class R, class L1, class L2>
+template <std::size_t I, class L1, class L2>
+using interleaved_at = at<I / 2, std::conditional_t<(I % 2 == 0), L1, L2>>;
+
+template <class L1, class L2, class Indices>
 struct interleave_impl;
 
+template <class L1, class L2, std::size_t... Is>
+struct interleave_impl<L1, L2, std::index_sequence<Is...>>
+    : list<interleaved_at<Is, L1, L2>...> {};
 
-template <class... Rs, class T1, class... T1s, class T2, class... T2s>
-struct interleave_impl<list<Rs...>, list<T1, T1s...>, list<T2, T2s...>>
-    : interleave_impl<list<Rs..., T1, T2>, list<T1s...>, list<T2s...>> {};
+template <class L1, class L2>
+struct interleave_list;
 
-template <class... Rs>
-struct interleave_impl<list<Rs...>, list<>, list<>> : list<Rs...> {};
+template <class... T1s, class... T2s>
+struct interleave_list<list<T1s...>, list<T2s...>>
+    : interleave_impl<list<T1s...>, list<T2s...>, std::make_index_sequence<2 * sizeof...(T1s)>> {
+    static_assert(sizeof...(T1s) == sizeof...(T2s), "Interleaved lists must be of equal size.");
+};
 
 }  // namespace detail
 
 template <class L1, class L2>
-using interleave = typename detail::interleave_impl<list<>, L1, L2>::type;
+using interleave = typename detail::interleave_list<L1, L2>::type;
+
+/// @brief Concatenate a list of lists
+namespace detail {
+
+template <class L>
+struct concat_impl;
+
+template <>
+struct concat_impl<list<>> : list<> {};
+
+template <class... Ts>
+struct concat_impl<list<list<Ts...>>> : list<Ts...> {};
+
+template <class... T1s, class... T2s, class... Ls>
+struct concat_impl<list<list<T1s...>, list<T2s...>, Ls...>>
+    : concat_impl<list<list<T1s..., T2s...>, Ls...>> {};
+
+}  // namespace detail
+
+template <class L>
+using concat = typename detail::concat_impl<L>::type;
 
 /// @brief Obtain the front item in a list
 namespace detail {